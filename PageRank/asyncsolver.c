@@ -0,0 +1,377 @@
+/*
+ * File: asyncsolver.c
+ * Purpose: Calculates PageRank With Threads Which Update a Shared Rank Vector
+ * 			in Place, Without Waiting For Each Other Between Sweeps.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* Include Header */
+#include "asyncsolver.h"
+#include "pagerank.h"
+
+/*
+ * Find the Chunks Each Chunk's Pages Link To.
+ *  Note: These Are the Chunks Whose PageRank Depends on the Chunk, so They Are
+ *        Made Active Again Whenever an Update Changes it.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PARAM: num_chunks is the number of chunks.
+ * PARAM: target_start is a pointer receiving the offset of each chunk's first linked chunk.
+ * PRE: NONE
+ * POST: target_start allocated with num_chunks + 1 offsets.
+ * RETURN: array of the chunks each chunk links to, each listed once per chunk.
+ */
+unsigned int* linkChunks(WebGraph* graph, unsigned int num_chunks, size_t** target_start) {
+	/* Local Variables */
+	unsigned int *targets = NULL;
+	unsigned int *seen = NULL;
+	size_t *start = NULL;
+
+	unsigned int chunk = 0;
+	unsigned int target = 0;
+	size_t page = 0;
+	size_t edge = 0;
+	size_t count = 0;
+	int pass = 0;
+
+	start = (size_t*)malloc((num_chunks + 1) * sizeof(size_t));
+	seen = (unsigned int*)malloc((num_chunks + 1) * sizeof(unsigned int));
+	if (!start || !seen) handleError("\nUnable To Allocate Memory For Chunk Links.\n");
+
+	/* The First Pass Counts the Linked Chunks and the Second Records Them. */
+	for (pass = 0; pass < 2; pass++) {
+		for (chunk = 0; chunk < num_chunks; chunk++) seen[chunk] = num_chunks;
+
+		count = 0;
+		for (chunk = 0; chunk < num_chunks; chunk++) {
+			start[chunk] = count;
+			for (page = (size_t)chunk * CHUNK_PAGES; page < graph->dimension && page < (size_t)(chunk + 1) * CHUNK_PAGES; page++) {
+				for (edge = graph->out_start[page]; edge < graph->out_start[page + 1]; edge++) {
+					target = (unsigned int)(graph->out_target[edge] / CHUNK_PAGES);
+					if (seen[target] == chunk) continue;
+
+					seen[target] = chunk;
+					if (pass) targets[count] = target;
+					count++;
+				}
+			}
+		}
+		start[num_chunks] = count;
+
+		if (!pass) {
+			targets = (unsigned int*)malloc((count ? count : 1) * sizeof(unsigned int));
+			if (!targets) handleError("\nUnable To Allocate Memory For Chunk Links.\n");
+		}
+	}
+
+	free(seen);
+
+	*target_start = start;
+	return targets;
+}
+
+/*
+ * Take the Next Chunk From the Front of a Thread's Own Deque.
+ * PARAM: deque is a pointer to the ChunkDeque of the calling thread.
+ * PARAM: chunk is a pointer receiving the index of the chunk taken.
+ * PRE: NONE
+ * POST: chunk removed from the deque.
+ * RETURN: TRUE IF a chunk was taken
+ *          OTHERWISE FALSE
+ */
+int popChunk(ChunkDeque* deque, unsigned int* chunk) {
+	/* Local Variables */
+	unsigned long long range = 0;
+	unsigned long long updated = 0;
+	unsigned int front = 0;
+	unsigned int back = 0;
+
+	do {
+		range = deque->range;
+		front = (unsigned int)(range >> 32);
+		back = (unsigned int)range;
+		if (front >= back) return FALSE;
+
+		updated = ((unsigned long long)(front + 1) << 32) | back;
+	} while (!COMPARE_EXCHANGE(&deque->range, range, updated));
+
+	*chunk = front;
+	return TRUE;
+}
+
+/*
+ * Steal Half of the Chunks From the Back of Another Thread's Deque.
+ * PARAM: thief is a pointer to the empty ChunkDeque of the calling thread.
+ * PARAM: victim is a pointer to the ChunkDeque of another thread.
+ * PRE: thief's deque is empty.
+ * POST: chunks moved from the victim's deque to the thief's deque.
+ * RETURN: TRUE IF any chunks were stolen
+ *          OTHERWISE FALSE
+ */
+int stealChunks(ChunkDeque* thief, ChunkDeque* victim) {
+	/* Local Variables */
+	unsigned long long range = 0;
+	unsigned long long updated = 0;
+	unsigned int front = 0;
+	unsigned int back = 0;
+	unsigned int count = 0;
+
+	do {
+		range = victim->range;
+		front = (unsigned int)(range >> 32);
+		back = (unsigned int)range;
+		if (front >= back) return FALSE;
+
+		count = (back - front + 1) / 2;
+		updated = ((unsigned long long)front << 32) | (back - count);
+	} while (!COMPARE_EXCHANGE(&victim->range, range, updated));
+
+	/* Other Thieves Only Exchange a Deque Which is Not Empty, so This Always Succeeds Quickly. */
+	updated = ((unsigned long long)(back - count) << 32) | back;
+	do range = thief->range; while (!COMPARE_EXCHANGE(&thief->range, range, updated));
+
+	return TRUE;
+}
+
+/*
+ * Update the PageRank of the Pages in One Chunk in Place.
+ *  Note: Ranks of Linking Pages Are Read While Other Threads May Be Writing
+ *        Them, so Each Update Uses Whichever Value is Most Recent.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PARAM: share is the damped fraction of its rank each page passes along one link, before link weights.
+ * PARAM: pagerank is the shared rank vector.
+ * PARAM: chunk is the index of the chunk to update.
+ * PARAM: update is TRUE to store the new ranks, FALSE to only measure the change.
+ * PRE: NONE
+ * POST: pagerank of the chunk's pages is updated IF update is TRUE.
+ * RETURN: root mean square change to the chunk's pages.
+ */
+double updateChunk(WebGraph* graph, double* share, double* pagerank, unsigned int chunk, int update) {
+	/* Local Variables */
+	size_t first = (size_t)chunk * CHUNK_PAGES;
+	size_t last = first + CHUNK_PAGES < graph->dimension ? first + CHUNK_PAGES : graph->dimension;
+	size_t page = 0;
+	size_t edge = 0;
+
+	double rank = 0;
+	double previous = 0;
+	double change = 0;
+
+	for (page = first; page < last; page++) {
+		rank = 1;
+		if (graph->in_weight) {
+			for (edge = graph->in_start[page]; edge < graph->in_start[page + 1]; edge++) rank += share[graph->in_source[edge]] * graph->in_weight[edge] * LOAD_RELAXED(&pagerank[graph->in_source[edge]]);
+		}
+		else {
+			for (edge = graph->in_start[page]; edge < graph->in_start[page + 1]; edge++) rank += share[graph->in_source[edge]] * LOAD_RELAXED(&pagerank[graph->in_source[edge]]);
+		}
+
+		previous = LOAD_RELAXED(&pagerank[page]);
+		change += (rank - previous) * (rank - previous);
+		if (update) STORE_RELAXED(&pagerank[page], rank);
+	}
+
+	return sqrt(change) / (last - first);
+}
+
+/*
+ * Count the Chunks Whose PageRank Would Still Change by More Than ASYNC_TOLERANCE.
+ *  Note: Threads Stop Once No Chunk is Active, but Changes Too Small to Make
+ *        a Chunk Active Again May Have Added Up. Every Chunk is Measured Again
+ *        Here Without Other Threads Writing.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PARAM: share is the damped fraction of its rank each page passes along one link, before link weights.
+ * PARAM: pagerank is the shared rank vector.
+ * PARAM: chunk_active is the array of flags marking chunks still changing.
+ * PARAM: num_chunks is the number of chunks.
+ * PRE: no thread is updating pagerank.
+ * POST: chunk_active marks every chunk still changing.
+ * RETURN: number of chunks still changing.
+ */
+long verifyChunks(WebGraph* graph, double* share, double* pagerank, volatile long* chunk_active, unsigned int num_chunks) {
+	/* Local Variables */
+	long active_chunks = 0;
+	int chunk = 0;
+
+	#pragma omp parallel for reduction(+:active_chunks)
+	for (chunk = 0; chunk < (int)num_chunks; chunk++) {
+		chunk_active[chunk] = updateChunk(graph, share, pagerank, chunk, FALSE) > ASYNC_TOLERANCE;
+		active_chunks += chunk_active[chunk];
+	}
+
+	return active_chunks;
+}
+
+/*
+ * Calculate the PageRank Asynchronously With Work-Stealing Threads.
+ *  Note: Solves the System of the Initial Approximation, (I - p * M * D) * x = e,
+ *        Whose Right Side Does Not Change, so Threads Need No Global Sums Between
+ *        Sweeps. Each Thread Sweeps its Own Range of Chunks and Steals From Other
+ *        Threads When it Runs Out. A Chunk Stops Being Updated Once it Stops
+ *        Changing, Until a Chunk Linking to it Changes Again. Threads Only Wait
+ *        For Each Other Once No Chunk is Active, When Every Chunk is Verified.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for asynchronous iteration.
+ * POST: pagerank stored in MATLAB array x.
+ * RETURN: VOID
+ */
+void calculateAsynchronous(Engine* ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	WebGraph *graph = NULL;
+	ChunkDeque *deques = NULL;
+
+	double *share = NULL;
+	double *pagerank = NULL;
+	volatile long *chunk_active = NULL;
+	volatile long *chunk_held = NULL;
+
+	unsigned int *targets = NULL;
+	size_t *target_start = NULL;
+
+	volatile long active_chunks = 0;
+	volatile long updates = 0;
+	volatile long steals = 0;
+
+	unsigned int num_chunks = 0;
+	unsigned int chunk = 0;
+	int num_threads = 1;
+	int rounds = 0;
+	int thread = 0;
+	size_t page = 0;
+	clock_t start = 0;
+
+	fprintf(stdout, "\nAsynchronous Calculation...\n");
+
+	graph = loadWebGraph();
+	num_chunks = (unsigned int)((graph->dimension + CHUNK_PAGES - 1) / CHUNK_PAGES);
+
+#ifdef _OPENMP
+	num_threads = omp_get_max_threads();
+#endif
+
+	share = (double*)malloc(graph->dimension * sizeof(double));
+	pagerank = (double*)malloc(graph->dimension * sizeof(double));
+	chunk_active = (volatile long*)malloc((num_chunks + 1) * sizeof(long));
+	chunk_held = (volatile long*)calloc(num_chunks + 1, sizeof(long));
+	deques = (ChunkDeque*)malloc(num_threads * sizeof(ChunkDeque));
+	if (!share || !pagerank || !chunk_active || !chunk_held || !deques) handleError("\nUnable To Allocate Memory For PageRank.\n");
+
+	targets = linkChunks(graph, num_chunks, &target_start);
+
+	computeShares(graph, share);
+	for (page = 0; page < graph->dimension; page++) pagerank[page] = 1;
+	/* Every Chunk Starts Active Unless a Converged Checkpoint of This Web Was Loaded. */
+	if (loadCheckpoint(ASYNCHRONOUS, graph->key, pagerank, graph->dimension, graph->out_degree, &rounds) != CHECKPOINT_COMPLETE) {
+		for (chunk = 0; chunk < num_chunks; chunk++) chunk_active[chunk] = TRUE;
+		active_chunks = num_chunks;
+	}
+
+	start = clock();
+	while (active_chunks) {
+		/* Every Thread Starts With its Own Range of Chunks. */
+		for (thread = 0; thread < num_threads; thread++) {
+			deques[thread].range = ((unsigned long long)(num_chunks * (unsigned long long)thread / num_threads) << 32)
+				| (num_chunks * (unsigned long long)(thread + 1) / num_threads);
+		}
+
+		#pragma omp parallel num_threads(num_threads)
+		{
+			int self = 0;
+			int victim = 0;
+			int stolen = FALSE;
+			long local_updates = 0;
+			long local_steals = 0;
+
+			unsigned int current = 0;
+			unsigned int front = 0;
+			unsigned int back = 0;
+			unsigned long long home = 0;
+			unsigned long long range = 0;
+			size_t link = 0;
+
+#ifdef _OPENMP
+			self = omp_get_thread_num();
+#endif
+			/* Other Threads May Already Have Stolen From This Deque, so the Range is Recomputed. */
+			home = ((unsigned long long)(num_chunks * (unsigned long long)self / num_threads) << 32)
+				| (num_chunks * (unsigned long long)(self + 1) / num_threads);
+
+			/* Every Active Chunk is Counted, and Only an Update of an Active Chunk Makes Others
+			   Active, so Once the Count Reaches Zero No Thread Can Raise it Again. */
+			while (active_chunks) {
+				if (!popChunk(&deques[self], &current)) {
+					stolen = FALSE;
+					for (victim = 1; victim < num_threads && !stolen; victim++) stolen = stealChunks(&deques[self], &deques[(self + victim) % num_threads]);
+
+					if (stolen) {
+						local_steals++;
+						continue;
+					}
+
+					/* Chunks Thieves Still Hold Are Theirs to Update, so This Thread's Own Range is
+					   Only Swept Again Once No Other Deque Holds Any of its Chunks. */
+					for (victim = 1; victim < num_threads; victim++) {
+						range = deques[(self + victim) % num_threads].range;
+						front = (unsigned int)(range >> 32);
+						back = (unsigned int)range;
+						if (front < back && front < (unsigned int)home && back > (unsigned int)(home >> 32)) break;
+					}
+					if (victim < num_threads) continue;
+
+					for (current = (unsigned int)(home >> 32); current < (unsigned int)home && !chunk_active[current]; current++);
+					if (current == (unsigned int)home) continue;
+
+					/* Start the Next Sweep of This Thread's Own Range Without Waiting For Other Threads. */
+					do range = deques[self].range; while (!COMPARE_EXCHANGE(&deques[self].range, range, home));
+					continue;
+				}
+
+				/* A Chunk is Checked Again Once Held, so an Update Never Starts on an Inactive Chunk. */
+				if (!chunk_active[current] || EXCHANGE(&chunk_held[current], TRUE)) continue;
+				if (chunk_active[current]) {
+					if (updateChunk(graph, share, pagerank, current, TRUE) > ASYNC_TOLERANCE) {
+						/* The Chunk Stays Active, and Every Chunk it Links to Has to be Updated Again. */
+						for (link = target_start[current]; link < target_start[current + 1]; link++) {
+							if (!EXCHANGE(&chunk_active[targets[link]], TRUE)) FETCH_ADD(&active_chunks, 1);
+						}
+					}
+					else if (EXCHANGE(&chunk_active[current], FALSE)) FETCH_ADD(&active_chunks, -1);
+
+					local_updates++;
+				}
+				EXCHANGE(&chunk_held[current], FALSE);
+			}
+
+			FETCH_ADD(&updates, local_updates);
+			FETCH_ADD(&steals, local_steals);
+		}
+
+		/* Changes Smaller Than ASYNC_TOLERANCE Do Not Make Linked Chunks Active, so Every
+		   Chunk is Measured Once More Before the Calculation Ends. */
+		active_chunks = verifyChunks(graph, share, pagerank, chunk_active, num_chunks);
+		rounds++;
+
+		/* Threads Are Idle Between Rounds, so the Rank Vector is Consistent to Save. */
+		if (!(rounds % CHECKPOINT_PERIOD) || !active_chunks) saveCheckpoint(ASYNCHRONOUS, graph->key, pagerank, graph->dimension, rounds, !active_chunks);
+	}
+
+	fprintf(stdout, "\nAsynchronous : %i Threads, %ld Chunk Updates (%.2f Sweeps), %ld Steals, %i Rounds In %.6f Seconds\n",
+		num_threads, updates, num_chunks ? (double)updates / num_chunks : 0, steals, rounds, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	storePageRank(ep, pagerank, graph->dimension);
+
+	/* Deallocate Memory. */
+	freeWebGraph(graph);
+	free(share);
+	free(pagerank);
+	free((void*)chunk_active);
+	free((void*)chunk_held);
+	free(targets);
+	free(target_start);
+	free(deques);
+}
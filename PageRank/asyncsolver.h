@@ -0,0 +1,82 @@
+/*
+ * File: asyncsolver.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "engine.h"
+#include "websolver.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+/* Pages Updated Together as One Unit of Work. */
+#define CHUNK_PAGES 256
+
+/* Deques Are Padded to a Cache Line so Threads Do Not Contend on Neighbouring Deques. */
+#define CACHE_LINE 64
+
+/* A Chunk Stays Active Until an Update Changes it by Less Than This. */
+#define ASYNC_TOLERANCE 1e-10
+
+/* Relaxed Atomic Accesses. Aligned 64-Bit Loads and Stores Are Single Instructions
+   on the Targets MSVC Builds For, so Volatile Accesses Suffice There. */
+#ifdef _MSC_VER
+#define LOAD_RELAXED(pointer) (*(volatile double*)(pointer))
+#define STORE_RELAXED(pointer, value) (*(volatile double*)(pointer) = (value))
+#define FETCH_ADD(pointer, value) _InterlockedExchangeAdd((volatile long*)(pointer), (value))
+#define EXCHANGE(pointer, value) _InterlockedExchange((volatile long*)(pointer), (value))
+#define COMPARE_EXCHANGE(pointer, expected, desired) \
+	(_InterlockedCompareExchange64((volatile long long*)(pointer), (long long)(desired), (long long)(expected)) == (long long)(expected))
+#else
+#define LOAD_RELAXED(pointer) __extension__ ({ double loaded_; __atomic_load((pointer), &loaded_, __ATOMIC_RELAXED); loaded_; })
+#define STORE_RELAXED(pointer, value) __extension__ ({ double stored_ = (value); __atomic_store((pointer), &stored_, __ATOMIC_RELAXED); })
+#define FETCH_ADD(pointer, value) __atomic_fetch_add((pointer), (value), __ATOMIC_ACQ_REL)
+#define EXCHANGE(pointer, value) __atomic_exchange_n((pointer), (value), __ATOMIC_ACQ_REL)
+#define COMPARE_EXCHANGE(pointer, expected, desired) \
+	__atomic_compare_exchange_n((pointer), &(expected), (desired), FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#endif
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Range of Chunks Left to a Thread, Packed as (front << 32 | back) so the Owner
+   Popping From the Front and Thieves Stealing From the Back Agree With One Exchange. */
+typedef struct {
+	volatile unsigned long long range;
+	char padding[CACHE_LINE - sizeof(unsigned long long)];
+} ChunkDeque;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+unsigned int* linkChunks(WebGraph* graph, unsigned int num_chunks, size_t** target_start);
+int popChunk(ChunkDeque* deque, unsigned int* chunk);
+int stealChunks(ChunkDeque* thief, ChunkDeque* victim);
+double updateChunk(WebGraph* graph, double* share, double* pagerank, unsigned int chunk, int update);
+long verifyChunks(WebGraph* graph, double* share, double* pagerank, volatile long* chunk_active, unsigned int num_chunks);
+void calculateAsynchronous(Engine* ep);
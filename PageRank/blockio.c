@@ -0,0 +1,249 @@
+/*
+ * File: blockio.c
+ * Purpose: Reads Binary Files in Blocks Through Overlapped Reads on Windows
+ * 			and a Reader Thread on POSIX, so the Solvers Share One Interface.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#ifdef _WIN32
+/* Exclude GDI Which Redefines ERROR. */
+#define NOGDI
+#include <windows.h>
+#else
+/* Expose pread and posix_fadvise in Strict C Modes. */
+#define _POSIX_C_SOURCE 200809L
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+/* Include Header */
+#include "blockio.h"
+#include "pagerank.h"
+
+#ifndef _WIN32
+/* Reads Requested From a Block File, Performed in Request Order by its Reader Thread. */
+typedef struct {
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+
+	/* Sequence Number of Each Slot's Request, or 0 Once it is Read. */
+	unsigned long long requested[BLOCK_READS];
+	unsigned long long next_request;
+
+	/* Bytes Read For Each Slot, or ERROR IF the Read Failed. */
+	long long num_read[BLOCK_READS];
+	int closing;
+} BlockReader;
+
+/*
+ * Perform the Reads Requested From a Block File, Oldest First.
+ * PARAM: argument is a pointer to the BlockFile whose reads are performed.
+ * PRE: NONE
+ * POST: every requested read is performed until the file is closed.
+ * RETURN: NULL
+ */
+static void* readBlocks(void* argument) {
+	/* Local Variables */
+	BlockFile *file = (BlockFile*)argument;
+	BlockReader *reader = (BlockReader*)file->requests;
+
+	ssize_t bytes = 0;
+	size_t num_read = 0;
+	int slot = 0;
+	int oldest = 0;
+
+	pthread_mutex_lock(&reader->lock);
+	while (TRUE) {
+		oldest = ERROR;
+		for (slot = 0; slot < BLOCK_READS; slot++) {
+			if (reader->requested[slot] && (oldest == ERROR || reader->requested[slot] < reader->requested[oldest])) oldest = slot;
+		}
+
+		if (oldest == ERROR) {
+			if (reader->closing) break;
+			pthread_cond_wait(&reader->changed, &reader->lock);
+			continue;
+		}
+		pthread_mutex_unlock(&reader->lock);
+
+		/* The Caller Does Not Touch the Slot Until the Read is Reported. */
+		for (num_read = 0; num_read < file->bytes[oldest]; num_read += (size_t)bytes) {
+			bytes = pread(file->descriptor, (char*)file->buffer[oldest] + num_read, file->bytes[oldest] - num_read, (off_t)(file->offset[oldest] + num_read));
+			if (bytes <= 0) break;
+		}
+
+		pthread_mutex_lock(&reader->lock);
+		reader->num_read[oldest] = bytes <= 0 && num_read < file->bytes[oldest] ? ERROR : (long long)num_read;
+		reader->requested[oldest] = 0;
+		pthread_cond_broadcast(&reader->changed);
+	}
+	pthread_mutex_unlock(&reader->lock);
+
+	return NULL;
+}
+#endif
+
+/*
+ * Opens a Binary File For Block Reads.
+ * PARAM: name is the path of the file.
+ * PRE: NONE
+ * POST: file is opened for sequential block reads.
+ * RETURN: dynamically allocated BlockFile, released with closeBlockFile.
+ */
+BlockFile* openBlockFile(char* name) {
+	/* Local Variables */
+	BlockFile *file = NULL;
+	int slot = 0;
+
+	file = (BlockFile*)calloc(1, sizeof(BlockFile));
+	if (!file) handleError("\nUnable To Allocate Memory For Block File.\n");
+
+#ifdef _WIN32
+	LARGE_INTEGER file_size;
+	OVERLAPPED *requests = (OVERLAPPED*)calloc(BLOCK_READS, sizeof(OVERLAPPED));
+	if (!requests) handleError("\nUnable To Allocate Memory For Block File.\n");
+
+	file->handle = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file->handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(file->handle, &file_size)) handleError("\nUnable To Open Block File.\n");
+
+	for (slot = 0; slot < BLOCK_READS; slot++) {
+		requests[slot].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (!requests[slot].hEvent) handleError("\nUnable To Allocate Memory For Block File.\n");
+	}
+
+	file->size = file_size.QuadPart;
+	file->requests = requests;
+#else
+	struct stat file_status;
+	BlockReader *reader = (BlockReader*)calloc(1, sizeof(BlockReader));
+	if (!reader) handleError("\nUnable To Allocate Memory For Block File.\n");
+
+	file->descriptor = open(name, O_RDONLY);
+	if (file->descriptor < 0 || fstat(file->descriptor, &file_status)) handleError("\nUnable To Open Block File.\n");
+
+	/* The Operating System Reads Ahead of Sequential Scans. */
+	posix_fadvise(file->descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+	file->size = (long long)file_status.st_size;
+	file->requests = reader;
+
+	/* Reads Are Performed by a Thread of Their Own so They Overlap the Caller. */
+	for (slot = 0; slot < BLOCK_READS; slot++) reader->requested[slot] = 0;
+	reader->next_request = 1;
+	if (pthread_mutex_init(&reader->lock, NULL) || pthread_cond_init(&reader->changed, NULL) || pthread_create(&reader->thread, NULL, readBlocks, file))
+		handleError("\nUnable To Start Block Reader.\n");
+#endif
+
+	return file;
+}
+
+/*
+ * Request a Read of a Block.
+ * PARAM: file is a pointer to a BlockFile returned by openBlockFile.
+ * PARAM: slot is the index of the read, less than BLOCK_READS.
+ * PARAM: buffer is the buffer receiving the block.
+ * PARAM: offset is the byte offset of the block in the file.
+ * PARAM: bytes is the size of a full block in bytes.
+ * PRE: offset is less than the size of the file; no read is in flight for slot.
+ * POST: read of up to bytes bytes is in flight.
+ * RETURN: VOID
+ */
+void requestBlock(BlockFile* file, int slot, void* buffer, long long offset, size_t bytes) {
+	/* Local Variables */
+	long long remaining = file->size - offset;
+
+	file->buffer[slot] = buffer;
+	file->offset[slot] = offset;
+	file->bytes[slot] = remaining < (long long)bytes ? (size_t)remaining : bytes;
+
+#ifdef _WIN32
+	OVERLAPPED *request = (OVERLAPPED*)file->requests + slot;
+
+	request->Offset = (DWORD)(offset & 0xFFFFFFFF);
+	request->OffsetHigh = (DWORD)(offset >> 32);
+	ResetEvent(request->hEvent);
+
+	if (!ReadFile(file->handle, buffer, (DWORD)file->bytes[slot], NULL, request) && GetLastError() != ERROR_IO_PENDING)
+		handleError("\nUnable To Read Block File.\n");
+#else
+	BlockReader *reader = (BlockReader*)file->requests;
+
+	pthread_mutex_lock(&reader->lock);
+	reader->requested[slot] = reader->next_request++;
+	pthread_cond_broadcast(&reader->changed);
+	pthread_mutex_unlock(&reader->lock);
+#endif
+}
+
+/*
+ * Wait For a Requested Block to Be Read.
+ * PARAM: file is a pointer to a BlockFile returned by openBlockFile.
+ * PARAM: slot is the index of the read passed to requestBlock.
+ * PRE: read requested for slot.
+ * POST: buffer passed to requestBlock holds the block.
+ * RETURN: number of bytes read.
+ */
+size_t waitBlock(BlockFile* file, int slot) {
+	/* Local Variables */
+	size_t num_read = 0;
+
+#ifdef _WIN32
+	DWORD bytes = 0;
+
+	if (!GetOverlappedResult(file->handle, (OVERLAPPED*)file->requests + slot, &bytes, TRUE)) handleError("\nUnable To Read Block File.\n");
+	num_read = bytes;
+#else
+	BlockReader *reader = (BlockReader*)file->requests;
+
+	pthread_mutex_lock(&reader->lock);
+	while (reader->requested[slot]) pthread_cond_wait(&reader->changed, &reader->lock);
+	if (reader->num_read[slot] == ERROR) handleError("\nUnable To Read Block File.\n");
+	num_read = (size_t)reader->num_read[slot];
+	pthread_mutex_unlock(&reader->lock);
+#endif
+
+	if (num_read != file->bytes[slot]) handleError("\nUnable To Read Block File.\n");
+
+	return num_read;
+}
+
+/*
+ * Closes a Block File.
+ * PARAM: file is a pointer to a BlockFile returned by openBlockFile.
+ * PRE: no read is in flight.
+ * POST: file closed and its memory released.
+ * RETURN: VOID
+ */
+void closeBlockFile(BlockFile* file) {
+	if (!file) return;
+
+#ifdef _WIN32
+	int slot = 0;
+
+	for (slot = 0; slot < BLOCK_READS; slot++) CloseHandle(((OVERLAPPED*)file->requests)[slot].hEvent);
+	CloseHandle(file->handle);
+	free(file->requests);
+#else
+	BlockReader *reader = (BlockReader*)file->requests;
+
+	pthread_mutex_lock(&reader->lock);
+	reader->closing = TRUE;
+	pthread_cond_broadcast(&reader->changed);
+	pthread_mutex_unlock(&reader->lock);
+
+	pthread_join(reader->thread, NULL);
+	pthread_mutex_destroy(&reader->lock);
+	pthread_cond_destroy(&reader->changed);
+	free(reader);
+
+	close(file->descriptor);
+#endif
+
+	free(file);
+}
@@ -0,0 +1,52 @@
+/*
+ * File: blockio.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "websolver.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+/* Reads Which May Be in Flight at Once, One Per Buffer. */
+#define BLOCK_READS 2
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Binary File Read in Blocks. Reads Overlap the Caller Through Overlapped Reads on
+   Windows and a Reader Thread Performing Each Read With pread on POSIX. */
+typedef struct {
+	long long size;
+
+	void *handle;
+	int descriptor;
+	void *requests;
+
+	void *buffer[BLOCK_READS];
+	long long offset[BLOCK_READS];
+	size_t bytes[BLOCK_READS];
+} BlockFile;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+BlockFile* openBlockFile(char* name);
+void requestBlock(BlockFile* file, int slot, void* buffer, long long offset, size_t bytes);
+size_t waitBlock(BlockFile* file, int slot);
+void closeBlockFile(BlockFile* file);
@@ -0,0 +1,337 @@
+/*
+ * File: blockstream.c
+ * Purpose: Calculates PageRank Out-of-Core by Partitioning the Web File Into
+ * 			Destination-Ordered Edge Blocks on Disk and Streaming Them Each Iteration.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* Include Header */
+#include "blockstream.h"
+#include "pagerank.h"
+
+/*
+ * Partitions the Web File Into Edge Blocks on Disk.
+ *  Note: The Web File Lists Incoming Links Row by Row, so Edges Are Written
+ *        in Destination Order and Each Block Covers a Contiguous Range of Pages.
+ *        Only the Source of Each Edge is Written. Its Destination Follows From
+ *        the Per-Page Link Offsets and the Destination of Each Block's First
+ *        Edge, Which Are Kept in Memory With the Out-Degree Vector. Link Weights
+ *        Are Written to WEIGHT_FILE in the Same Order, Starting From the First
+ *        Link Whose Weight is Not One, so Unweighted Webs Never Write Weights.
+ * PARAM: web_file is a pointer to a filestream
+ * PARAM: dimension is a variable of type size_t representing the size of the matrix.
+ * PARAM: out_weight is a pointer receiving the weight sum of each page's outgoing links.
+ * PARAM: in_start is a pointer receiving the index of the first link into each page.
+ * PARAM: block_page is a pointer receiving the destination of the first link of each block.
+ * PRE: web_file is a pointer to a correctly-formatted matrix file.
+ * PRE: dimension contains the correct size of the square matrix.
+ * POST: BLOCK_FILE contains the source of every link in the web file; WEIGHT_FILE
+ *       contains every link weight IF the web is weighted; web_file's internal
+ *       pointer is set to beginning of stream.
+ * POST: in_start and block_page are dynamically allocated arrays.
+ * POST: out_weight is a dynamically allocated array IF the web is weighted
+ *       OTHERWISE NULL
+ * RETURN: dynamically allocated array with the number of outgoing links from each page.
+ */
+unsigned int* partitionWeb(FILE* web_file, size_t dimension, double** out_weight, size_t** in_start, size_t** block_page) {
+	/* Local Variables */
+	FILE *block_file = NULL;
+	FILE *weight_file = NULL;
+
+	WebLinks links = { 0, 0, NULL, NULL };
+	unsigned int *block = NULL;
+	double *weights = NULL;
+	size_t block_size = 0;
+	size_t num_written = 0;
+	size_t num_blocks = 0;
+
+	unsigned int *out_degree = NULL;
+	double unit = 1;
+
+	size_t row = 0;
+	size_t link = 0;
+	size_t edge = 0;
+	size_t page = 0;
+
+	if (fopen_s(&block_file, BLOCK_FILE, "wb") || !block_file) handleError("\nUnable To Create Block File.\n");
+	remove(WEIGHT_FILE);
+
+	out_degree = (unsigned int*)calloc(dimension, sizeof(unsigned int));
+	*out_weight = (double*)calloc(dimension, sizeof(double));
+	*in_start = (size_t*)calloc(dimension + 1, sizeof(size_t));
+	block = (unsigned int*)malloc(BLOCK_EDGES * sizeof(unsigned int));
+	weights = (double*)malloc(BLOCK_EDGES * sizeof(double));
+	if (!out_degree || !*out_weight || !*in_start || !block || !weights) handleError("\nUnable To Allocate Memory For Edge Blocks.\n");
+
+	/* Only One Row of Links is Held in Memory at a Time. */
+	for (row = 0; row < dimension; row++) {
+		links.num_links = 0;
+		readWebRow(web_file, dimension, &links, handleError);
+
+		/* Links Already on Disk Had Weight One. */
+		if (links.weight && !weight_file) {
+			if (fopen_s(&weight_file, WEIGHT_FILE, "wb") || !weight_file) handleError("\nUnable To Create Weight File.\n");
+			for (edge = 0; edge < num_written; edge++) {
+				if (fwrite(&unit, sizeof(double), 1, weight_file) != 1) handleError("\nUnable To Write Weight File.\n");
+			}
+		}
+
+		(*in_start)[row + 1] = (*in_start)[row] + links.num_links;
+		for (link = 0; link < links.num_links; link++) {
+			block[block_size] = links.source[link];
+			weights[block_size] = links.weight ? links.weight[link] : 1;
+			out_degree[links.source[link]]++;
+			(*out_weight)[links.source[link]] += weights[block_size];
+
+			/* Flush Full Blocks to Disk. */
+			if (++block_size == BLOCK_EDGES) {
+				if (fwrite(block, sizeof(unsigned int), block_size, block_file) != block_size) handleError("\nUnable To Write Block File.\n");
+				if (weight_file && fwrite(weights, sizeof(double), block_size, weight_file) != block_size) handleError("\nUnable To Write Weight File.\n");
+				num_written += block_size;
+				block_size = 0;
+			}
+		}
+	}
+
+	if (fwrite(block, sizeof(unsigned int), block_size, block_file) != block_size) handleError("\nUnable To Write Block File.\n");
+	if (weight_file && fwrite(weights, sizeof(double), block_size, weight_file) != block_size) handleError("\nUnable To Write Weight File.\n");
+
+	fclose(block_file);
+	free(block);
+	free(weights);
+	free(links.source);
+	free(links.weight);
+
+	if (weight_file) fclose(weight_file);
+	else {
+		free(*out_weight);
+		*out_weight = NULL;
+	}
+
+	/* A Block's First Edge Belongs to the Page Whose Links Have Not All Been Written Before it. */
+	num_blocks = ((*in_start)[dimension] + BLOCK_EDGES - 1) / BLOCK_EDGES;
+	*block_page = (size_t*)malloc((num_blocks + 1) * sizeof(size_t));
+	if (!*block_page) handleError("\nUnable To Allocate Memory For Edge Blocks.\n");
+
+	for (edge = 0, page = 0; edge < num_blocks; edge++) {
+		while ((*in_start)[page + 1] <= edge * BLOCK_EDGES) page++;
+		(*block_page)[edge] = page;
+	}
+
+	fseek(web_file, FALSE, SEEK_SET);
+
+	return out_degree;
+}
+
+/*
+ * Determine Whether a Web is Small Enough to Solve as a Dense Matrix in MATLAB.
+ *  Note: The Budget is IN_CORE_MEMORY MiB Unless the MEMORY_VARIABLE Environment
+ *        Variable Gives Another Number of MiB.
+ * PARAM: dimension is a variable of type size_t representing the number of pages.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: TRUE IF IN_CORE_COPIES dense copies of the matrix fit in the memory budget
+ *          OTHERWISE FALSE
+ */
+int fitsInCore(size_t dimension) {
+	/* Local Variables */
+	char *variable = getenv(MEMORY_VARIABLE);
+	double budget = IN_CORE_MEMORY;
+	double footprint = (double)dimension * dimension * sizeof(double) * IN_CORE_COPIES;
+
+	if (variable && atof(variable) > 0) budget = atof(variable);
+
+	return footprint <= budget * (1 << 20);
+}
+
+/*
+ * Stream Every Edge Block and Accumulate the Link Contributions to Each Page.
+ *  Note: Two Buffers Are Used so the Next Block is Requested While the Current
+ *        Block is Being Processed. Weights Are Streamed Alongside the Edges Only
+ *        For Weighted Webs, Whose Blocks Are Added by Another Kernel.
+ * PARAM: stream is the StreamKernel returned by selectStreamKernel.
+ * PARAM: block_file is a pointer to the BlockFile of the edge sources.
+ * PARAM: weight_file is a pointer to the BlockFile of the weights, or NULL IF the web is unweighted.
+ * PARAM: in_start is the index of the first link into each page.
+ * PARAM: block_page is the destination of the first link of each block.
+ * PARAM: blocks is an array of two buffers holding BLOCK_EDGES edge sources.
+ * PARAM: weights is an array of two buffers holding BLOCK_EDGES weights.
+ * PARAM: share is the rank each page passes along each of its outgoing links, per unit weight.
+ * PARAM: pagerank is the rank vector receiving the contributions.
+ * PRE: block file and weight file written by partitionWeb.
+ * POST: pagerank incremented by the share of every incoming link.
+ * RETURN: VOID
+ */
+static void streamBlocks(StreamKernel stream, BlockFile* block_file, BlockFile* weight_file, const size_t* in_start, const size_t* block_page,
+	unsigned int** blocks, double** weights, double* share, double* pagerank) {
+	/* Local Variables */
+	long long offset = 0;
+	size_t bytes = 0;
+
+	int current = 0;
+	size_t first = 0;
+	size_t num_edges = 0;
+
+	if (block_file->size == 0) return;
+
+	requestBlock(block_file, current, blocks[current], offset, BLOCK_EDGES * sizeof(unsigned int));
+	if (weight_file) requestBlock(weight_file, current, weights[current], 0, BLOCK_EDGES * sizeof(double));
+
+	while (offset < block_file->size) {
+		bytes = waitBlock(block_file, current);
+		first = (size_t)(offset / sizeof(unsigned int));
+		num_edges = bytes / sizeof(unsigned int);
+
+		if (weight_file && waitBlock(weight_file, current) != num_edges * sizeof(double)) handleError("\nUnable To Read Weight File.\n");
+
+		/* Read Ahead Into the Other Buffer. */
+		offset += bytes;
+		if (offset < block_file->size) {
+			requestBlock(block_file, !current, blocks[!current], offset, BLOCK_EDGES * sizeof(unsigned int));
+			if (weight_file) requestBlock(weight_file, !current, weights[!current], offset / sizeof(unsigned int) * sizeof(double), BLOCK_EDGES * sizeof(double));
+		}
+
+		stream(blocks[current], weight_file ? weights[current] : NULL, in_start, block_page[first / BLOCK_EDGES], first, num_edges, share, pagerank);
+
+		current = !current;
+	}
+}
+
+/*
+ * Calculate the PageRank With the Power Method Out-of-Core.
+ *  Note: Only the Rank Vectors, Out-Degrees and Weight Sums Are Kept in Memory.
+ *        Links and Their Weights Are Streamed From Disk Every Iteration.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for out-of-core power method.
+ * POST: pagerank stored in MATLAB array x.
+ * RETURN: VOID
+ */
+void calculateOutOfCore(Engine* ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	FILE *web_file = NULL;
+	size_t dimension = 0;
+	unsigned long long key = 0;
+
+	BlockFile *block_file = NULL;
+	BlockFile *weight_file = NULL;
+	unsigned int *blocks[2] = { NULL, NULL };
+	double *weights[2] = { NULL, NULL };
+	StreamKernel stream = NULL;
+
+	unsigned int *out_degree = NULL;
+	double *out_weight = NULL;
+	size_t *in_start = NULL;
+	size_t *block_page = NULL;
+	double *x_prev = NULL;
+	double *x_curr = NULL;
+	double *share = NULL;
+	double *swap = NULL;
+
+	double dangling = 0;
+	double total = 0;
+	double teleport = 0;
+	double residual = 0;
+
+	size_t page = 0;
+	int iterations = 0;
+	int converged = FALSE;
+	clock_t start = 0;
+
+	fprintf(stdout, "\nOut-of-Core Power Method Calculation...\n");
+
+	/* Try to Open and Parse the Web File Containing the Matrix. */
+	if (fopen_s(&web_file, WEB, "r")) handleError("\nUnable To Open Web File:\n");
+	else if (!web_file) handleError("\nUnable To Parse Web File:\n");
+
+	dimension = getDimension(web_file);
+	key = hashWeb(web_file);
+	out_degree = partitionWeb(web_file, dimension, &out_weight, &in_start, &block_page);
+	fclose(web_file);
+
+	block_file = openBlockFile(BLOCK_FILE);
+
+	blocks[0] = (unsigned int*)malloc(BLOCK_EDGES * sizeof(unsigned int));
+	blocks[1] = (unsigned int*)malloc(BLOCK_EDGES * sizeof(unsigned int));
+
+	/* Weights Are Only Streamed For Weighted Webs. */
+	if (out_weight) {
+		weight_file = openBlockFile(WEIGHT_FILE);
+
+		weights[0] = (double*)malloc(BLOCK_EDGES * sizeof(double));
+		weights[1] = (double*)malloc(BLOCK_EDGES * sizeof(double));
+
+		if (!weights[0] || !weights[1])
+			handleError("\nUnable To Allocate Memory For Out-of-Core PageRank.\n");
+	}
+	stream = selectStreamKernel(weight_file != NULL);
+
+	x_prev = (double*)malloc(dimension * sizeof(double));
+	x_curr = (double*)malloc(dimension * sizeof(double));
+	share = (double*)malloc(dimension * sizeof(double));
+
+	if (!blocks[0] || !blocks[1] || !x_prev || !x_curr || !share)
+		handleError("\nUnable To Allocate Memory For Out-of-Core PageRank.\n");
+
+	for (page = 0; page < dimension; page++) x_curr[page] = 1;
+	converged = loadCheckpoint(OUT_OF_CORE, key, x_curr, dimension, NULL, &iterations) == CHECKPOINT_COMPLETE;
+
+	/* Iterate to Calculate PageRank With Power Method Until PageRank Stops Changing. */
+	start = clock();
+	while (!converged) {
+		swap = x_prev; x_prev = x_curr; x_curr = swap;
+
+		/* Rank From Dangling Pages and Random Jumps is Spread Evenly Across All Pages. */
+		dangling = 0;
+		total = 0;
+		for (page = 0; page < dimension; page++) {
+			total += x_prev[page];
+			if (out_degree[page]) share[page] = DAMPING_FACTOR * x_prev[page] / (out_weight ? out_weight[page] : out_degree[page]);
+			else dangling += x_prev[page];
+		}
+		teleport = (DAMPING_FACTOR * dangling + (1 - DAMPING_FACTOR) * total) / dimension;
+
+		for (page = 0; page < dimension; page++) x_curr[page] = teleport;
+		streamBlocks(stream, block_file, weight_file, in_start, block_page, blocks, weights, share, x_curr);
+
+		residual = 0;
+		total = 0;
+		for (page = 0; page < dimension; page++) {
+			residual += fabs(x_curr[page] - x_prev[page]);
+			total += x_curr[page];
+		}
+		iterations++;
+
+		/* Save the Iterate Periodically so an Interrupted Solve Can Resume. */
+		if (!(iterations % CHECKPOINT_PERIOD)) saveCheckpoint(OUT_OF_CORE, key, x_curr, dimension, iterations, FALSE);
+
+		converged = residual <= RANK_TOLERANCE * total;
+	}
+
+	fprintf(stdout, "\nOut-of-Core Power Method : %i Iterations In %.6f Seconds\n", iterations, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	saveCheckpoint(OUT_OF_CORE, key, x_curr, dimension, iterations, TRUE);
+
+	storePageRank(ep, x_curr, dimension);
+
+	/* Deallocate Memory. */
+	closeBlockFile(block_file);
+	closeBlockFile(weight_file);
+
+	free(blocks[0]);
+	free(blocks[1]);
+	free(weights[0]);
+	free(weights[1]);
+	free(out_degree);
+	free(out_weight);
+	free(in_start);
+	free(block_page);
+	free(x_prev);
+	free(x_curr);
+	free(share);
+}
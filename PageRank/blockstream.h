@@ -0,0 +1,56 @@
+/*
+ * File: blockstream.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "engine.h"
+#include "websolver.h"
+#include "kernels.h"
+#include "blockio.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+#define BLOCK_FILE "web.blk"
+#define WEIGHT_FILE "web.wgt"
+
+/* Number of Edges Read From Disk at Once (4 MiB of Sources Per Block). */
+#define BLOCK_EDGES (1 << 20)
+
+/* Memory Budget in MiB For Solving a Web as a Dense Matrix in MATLAB, Unless
+   Set by the MEMORY_VARIABLE Environment Variable. Larger Webs Are Solved Out-of-Core. */
+#define IN_CORE_MEMORY 1024
+#define MEMORY_VARIABLE "PAGERANK_MEMORY"
+
+/* Dense Copies of the Matrix Held at Once : the Parsed Matrix, its MATLAB Array,
+   and MATLAB's Stochastic and Transition Matrices. */
+#define IN_CORE_COPIES 4
+
+#define DAMPING_FACTOR 0.85
+
+/* Native Power Methods Stop Once an Iteration Changes the Ranks by Less Than This
+   Fraction of Their Sum, Which Does Not Loosen as the Web Grows. */
+#define RANK_TOLERANCE 1e-8
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+int fitsInCore(size_t dimension);
+unsigned int* partitionWeb(FILE* web_file, size_t dimension, double** out_weight, size_t** in_start, size_t** block_page);
+void calculateOutOfCore(Engine* ep);
@@ -0,0 +1,270 @@
+/*
+ * File: checkpoint.c
+ * Purpose: Saves the PageRank and Iteration State of a Solve to Disk, and
+ * 			Warm Starts Later Solves of the Same or a Changed Web From it.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#ifdef _WIN32
+/* Exclude GDI Which Redefines ERROR. */
+#define NOGDI
+#include <windows.h>
+#endif
+
+/* Include Header */
+#include "checkpoint.h"
+#include "pagerank.h"
+
+/*
+ * Acquires a Hash of the Web File Which Identifies the Web in Checkpoints.
+ * PARAM: web_file is a pointer to a filestream
+ * PRE: web_file is an initialized pointer to a correctly-formatted text file
+ * POST: web_file's internal pointer is set to beginning of stream
+ * RETURN: FNV-1a hash of the contents of the web file.
+ */
+unsigned long long hashWeb(FILE* web_file) {
+	/* Local Variables */
+	unsigned long long key = HASH_OFFSET;
+	unsigned char file_buffer[OUTPUT_BUFF];
+	size_t num_read = 0;
+	size_t position = 0;
+
+	while ((num_read = fread(file_buffer, sizeof(unsigned char), OUTPUT_BUFF, web_file)) > 0) {
+		for (position = 0; position < num_read; position++) key = (key ^ file_buffer[position]) * HASH_PRIME;
+	}
+
+	fseek(web_file, FALSE, SEEK_SET);
+
+	return key;
+}
+
+/*
+ * Determine Whether a Method Iterates the Power Method or Solves the System
+ * of the Initial Approximation, as the Two Scale Their PageRank Differently.
+ * PARAM: method is a PAGERANK_METHODS value.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: TRUE IF the method iterates the power method
+ *          OTHERWISE FALSE
+ */
+static int isPowerMethod(int method) {
+	return method == POWER_METHOD || method == QUADRATIC_EXTRAPOLATION || method == OUT_OF_CORE || method == DISTRIBUTED;
+}
+
+/*
+ * Load a Checkpoint to Start a Solve From.
+ *  Note: A Checkpoint of the Same Web and Method Resumes the Solve Exactly.
+ *        Otherwise, the Saved PageRank Warm Starts the Solve. Pages Added Since
+ *        the Checkpoint Start From the Average Rank.
+ * PARAM: method is the PAGERANK_METHODS value of the solve.
+ * PARAM: key is the hash of the web file returned by hashWeb.
+ * PARAM: pagerank is the array receiving the starting page ranks.
+ * PARAM: dimension is the number of pages.
+ * PARAM: out_degree is the array of out-degrees, which may be NULL for power methods.
+ * PARAM: iterations is a pointer receiving the iterations already performed.
+ * PRE: NONE
+ * POST: pagerank holds the starting page ranks IF a checkpoint was loaded.
+ * RETURN: CHECKPOINT_STATUS of the loaded checkpoint.
+ */
+int loadCheckpoint(int method, unsigned long long key, double* pagerank, size_t dimension, unsigned int* out_degree, int* iterations) {
+	/* Local Variables */
+	FILE *checkpoint_file = NULL;
+	CheckpointHeader header;
+
+	size_t num_saved = 0;
+	size_t page = 0;
+	double total = 0;
+	double sum = 0;
+	double linked = 0;
+
+	if (!dimension || fopen_s(&checkpoint_file, CHECKPOINT_FILE, "rb") || !checkpoint_file) return CHECKPOINT_NONE;
+
+	if (fread(&header, sizeof(header), 1, checkpoint_file) != 1 || memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) || !header.dimension) {
+		fclose(checkpoint_file);
+		return CHECKPOINT_NONE;
+	}
+
+	num_saved = header.dimension < dimension ? (size_t)header.dimension : dimension;
+	if (fread(pagerank, sizeof(double), num_saved, checkpoint_file) != num_saved) {
+		fclose(checkpoint_file);
+		return CHECKPOINT_NONE;
+	}
+	fclose(checkpoint_file);
+
+	for (page = num_saved; page < dimension; page++) pagerank[page] = 1.0 / header.dimension;
+
+	for (page = 0; page < dimension; page++) {
+		sum += pagerank[page];
+		if (out_degree && out_degree[page]) linked += pagerank[page];
+	}
+
+	/* The Power Method Keeps the Sum of the PageRank at the Number of Pages. Summing
+	   (I - p * M * D) * x = e Instead Gives sum(x) = dim + p * (Rank of Linking Pages). */
+	if (header.key == key && header.method == method && header.dimension == dimension) total = header.total;
+	else if (isPowerMethod(method)) total = (double)dimension;
+	else total = dimension / (1 - DAMPING_FACTOR * linked / sum);
+
+	for (page = 0; page < dimension; page++) pagerank[page] *= total / sum;
+
+	if (header.key == key && header.method == method && header.dimension == dimension) {
+		*iterations = header.iterations;
+		if (header.complete) {
+			fprintf(stdout, "\nCheckpoint Converged at Iteration %i...\n", header.iterations);
+			return CHECKPOINT_COMPLETE;
+		}
+
+		fprintf(stdout, "\nResuming From Checkpoint at Iteration %i...\n", header.iterations);
+		return CHECKPOINT_RESUME;
+	}
+
+	fprintf(stdout, "\nWarm Start From Checkpoint...\n");
+	return CHECKPOINT_WARM;
+}
+
+/*
+ * Save a Checkpoint of a Solve.
+ *  Note: The Checkpoint is Written to a Temporary File First, Which Then Replaces
+ *        the Previous Checkpoint in One Step so a Checkpoint Always Exists.
+ * PARAM: method is the PAGERANK_METHODS value of the solve.
+ * PARAM: key is the hash of the web file returned by hashWeb.
+ * PARAM: pagerank is the array of current page ranks.
+ * PARAM: dimension is the number of pages.
+ * PARAM: iterations is the number of iterations performed.
+ * PARAM: complete is TRUE IF the solve has converged.
+ * PRE: NONE
+ * POST: CHECKPOINT_FILE holds the page ranks and iteration state.
+ * RETURN: VOID
+ */
+void saveCheckpoint(int method, unsigned long long key, double* pagerank, size_t dimension, int iterations, int complete) {
+	/* Local Variables */
+	FILE *checkpoint_file = NULL;
+	CheckpointHeader header;
+
+	size_t page = 0;
+	double rank = 0;
+	int written = TRUE;
+	int replaced = FALSE;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+	header.method = method;
+	header.iterations = iterations;
+	header.complete = complete;
+	header.key = key;
+	header.dimension = dimension;
+	for (page = 0; page < dimension; page++) header.total += pagerank[page];
+
+	if (fopen_s(&checkpoint_file, CHECKPOINT_TEMP, "wb") || !checkpoint_file) {
+		fprintf(stderr, "\nUnable To Save Checkpoint.\n");
+		return;
+	}
+
+	written = fwrite(&header, sizeof(header), 1, checkpoint_file) == 1;
+	for (page = 0; page < dimension && written; page++) {
+		rank = pagerank[page] / header.total;
+		written = fwrite(&rank, sizeof(double), 1, checkpoint_file) == 1;
+	}
+
+	if (fclose(checkpoint_file) || !written) {
+		fprintf(stderr, "\nUnable To Save Checkpoint.\n");
+		return;
+	}
+
+#ifdef _WIN32
+	replaced = MoveFileExA(CHECKPOINT_TEMP, CHECKPOINT_FILE, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	replaced = !rename(CHECKPOINT_TEMP, CHECKPOINT_FILE);
+#endif
+
+	/* The Temporary File is Left in Place IF it Could Not Replace the Checkpoint. */
+	if (!replaced) fprintf(stderr, "\nUnable To Replace Checkpoint. Saved to %s.\n", CHECKPOINT_TEMP);
+}
+
+/*
+ * Load a Checkpoint Into a PageRank Vector in the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PARAM: variable is the MATLAB vector holding the starting page ranks.
+ * PARAM: method is the PAGERANK_METHODS value of the solve.
+ * PARAM: iterations_variable is the MATLAB variable holding the iteration count.
+ * PARAM: previous_variable is the MATLAB vector holding the previous iterate.
+ * PRE: MATLAB engine successfully opened; variable holds the default
+ * 		starting page ranks; iterations_variable holds zero.
+ * POST: variable holds the starting page ranks from the checkpoint IF one was loaded;
+ * 		 iterations_variable holds the iterations already performed IF the solve resumes;
+ * 		 previous_variable equals variable IF the checkpoint had converged.
+ * RETURN: VOID
+ */
+void loadCheckpointVariable(Engine* ep, char* variable, int method, char* iterations_variable, char* previous_variable) {
+	if (!ep) return;
+
+	/* Local Variables */
+	FILE *web_file = NULL;
+	unsigned long long key = 0;
+	mxArray *pagerank = NULL;
+	mxArray *iterations = NULL;
+	size_t dimension = 0;
+	int saved_iterations = 0;
+	int status = CHECKPOINT_NONE;
+
+	if (fopen_s(&web_file, WEB, "r") || !web_file) handleError("\nUnable To Open Web File:\n");
+	key = hashWeb(web_file);
+	fclose(web_file);
+
+	pagerank = engGetVariable(ep, variable);
+	if (!pagerank) handleError("\nFailed to Retrieve PageRank Calculation.\n");
+	dimension = mxGetNumberOfElements(pagerank);
+
+	status = loadCheckpoint(method, key, mxGetPr(pagerank), dimension, NULL, &saved_iterations);
+	if (status != CHECKPOINT_NONE) {
+		if (engPutVariable(ep, variable, pagerank)) handleError("\nCannot Write Array to MATLAB.\n");
+	}
+
+	if (status == CHECKPOINT_RESUME || status == CHECKPOINT_COMPLETE) {
+		iterations = mxCreateDoubleScalar(saved_iterations);
+		if (!iterations || engPutVariable(ep, iterations_variable, iterations)) handleError("\nCannot Write Array to MATLAB.\n");
+		mxDestroyArray(iterations);
+	}
+
+	/* A Converged Checkpoint Needs No Iterations, so the Previous Iterate Matches it. */
+	if (status == CHECKPOINT_COMPLETE) {
+		if (engPutVariable(ep, previous_variable, pagerank)) handleError("\nCannot Write Array to MATLAB.\n");
+	}
+
+	mxDestroyArray(pagerank);
+}
+
+/*
+ * Save a Checkpoint of a PageRank Vector in the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PARAM: variable is the MATLAB vector holding the converged page ranks.
+ * PARAM: method is the PAGERANK_METHODS value of the solve.
+ * PARAM: iterations_variable is the MATLAB variable holding the iteration count.
+ * PRE: MATLAB engine successfully opened; solve has converged.
+ * POST: CHECKPOINT_FILE holds the page ranks and iteration state.
+ * RETURN: VOID
+ */
+void saveCheckpointVariable(Engine* ep, char* variable, int method, char* iterations_variable) {
+	if (!ep) return;
+
+	/* Local Variables */
+	FILE *web_file = NULL;
+	unsigned long long key = 0;
+	mxArray *pagerank = NULL;
+	mxArray *iterations = NULL;
+
+	if (fopen_s(&web_file, WEB, "r") || !web_file) handleError("\nUnable To Open Web File:\n");
+	key = hashWeb(web_file);
+	fclose(web_file);
+
+	pagerank = engGetVariable(ep, variable);
+	iterations = engGetVariable(ep, iterations_variable);
+	if (!pagerank || !iterations) handleError("\nFailed to Retrieve PageRank Calculation.\n");
+
+	saveCheckpoint(method, key, mxGetPr(pagerank), mxGetNumberOfElements(pagerank), (int)mxGetScalar(iterations), TRUE);
+
+	mxDestroyArray(pagerank);
+	mxDestroyArray(iterations);
+}
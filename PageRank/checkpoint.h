@@ -0,0 +1,72 @@
+/*
+ * File: checkpoint.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "engine.h"
+#include "websolver.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+#define CHECKPOINT_FILE "web.chk"
+#define CHECKPOINT_TEMP "web.chk.tmp"
+#define CHECKPOINT_MAGIC "PRCK"
+
+/* Iterations Between Checkpoints of Long Solves. */
+#define CHECKPOINT_PERIOD 10
+
+/* FNV-1a Hash of the Web File. */
+#define HASH_OFFSET 14695981039346656037ULL
+#define HASH_PRIME 1099511628211ULL
+
+/***********************/
+/**** Enumerations ****/
+/***********************/
+
+enum CHECKPOINT_STATUS {
+    CHECKPOINT_NONE = 0,
+    CHECKPOINT_WARM = 1,
+    CHECKPOINT_RESUME = 2,
+    CHECKPOINT_COMPLETE = 3
+};
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Checkpoint Header, Followed by dimension Normalized Page Ranks. */
+typedef struct {
+	char magic[4];
+	int method;
+	int iterations;
+	int complete;
+	unsigned long long key;
+	unsigned long long dimension;
+	double total;
+} CheckpointHeader;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+unsigned long long hashWeb(FILE* web_file);
+
+int loadCheckpoint(int method, unsigned long long key, double* pagerank, size_t dimension, unsigned int* out_degree, int* iterations);
+void saveCheckpoint(int method, unsigned long long key, double* pagerank, size_t dimension, int iterations, int complete);
+
+void loadCheckpointVariable(Engine* ep, char* variable, int method, char* iterations_variable, char* previous_variable);
+void saveCheckpointVariable(Engine* ep, char* variable, int method, char* iterations_variable);
@@ -0,0 +1,1058 @@
+/*
+ * File: distributed.c
+ * Purpose: Calculates PageRank Across Worker Processes Which Each Own a Range
+ * 			of Pages and Exchange the Shares of Boundary Pages With Each Other.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#ifndef _WIN32
+/* Expose getaddrinfo, readlink, fseeko and MSG_NOSIGNAL in Strict C Modes. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#ifdef _WIN32
+/* Exclude GDI Which Redefines ERROR. */
+#define NOGDI
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <process.h>
+#pragma comment(lib, "Ws2_32.lib")
+
+#define SEND_FLAGS 0
+#define SEEK_FILE _fseeki64
+#define TELL_FILE _ftelli64
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+
+typedef int SOCKET;
+#define INVALID_SOCKET -1
+#define closesocket close
+#define SEND_FLAGS MSG_NOSIGNAL
+#define SEEK_FILE fseeko
+#define TELL_FILE ftello
+#endif
+
+/* Include Header */
+#include "distributed.h"
+#include "pagerank.h"
+
+/* Doubles Are Sent as 64-Bit Words. */
+typedef char double_is_64_bits[sizeof(double) == sizeof(uint64_t) ? 1 : -1];
+
+/* Global Variables */
+char* program_path = NULL;
+
+/*
+ * Send an Entire Message Over a Socket.
+ * PARAM: connection is a connected SOCKET.
+ * PARAM: data is a pointer to the message.
+ * PARAM: bytes is the size of the message.
+ * PRE: NONE
+ * POST: message written to the socket.
+ * RETURN: TRUE IF the whole message was sent
+ *          OTHERWISE FALSE
+ */
+static int sendMessage(SOCKET connection, void* data, size_t bytes) {
+	/* Local Variables */
+	char *position = (char*)data;
+	int sent = 0;
+
+	while (bytes) {
+		sent = send(connection, position, (int)(bytes < INT32_MAX ? bytes : INT32_MAX), SEND_FLAGS);
+		if (sent <= 0) return FALSE;
+
+		position += sent;
+		bytes -= sent;
+	}
+	return TRUE;
+}
+
+/*
+ * Receive an Entire Message From a Socket.
+ * PARAM: connection is a connected SOCKET.
+ * PARAM: data is a pointer to the buffer receiving the message.
+ * PARAM: bytes is the size of the message.
+ * PRE: data holds at least bytes.
+ * POST: message read from the socket.
+ * RETURN: TRUE IF the whole message was received
+ *          OTHERWISE FALSE
+ */
+static int receiveMessage(SOCKET connection, void* data, size_t bytes) {
+	/* Local Variables */
+	char *position = (char*)data;
+	int received = 0;
+
+	while (bytes) {
+		received = recv(connection, position, (int)(bytes < INT32_MAX ? bytes : INT32_MAX), 0);
+		if (received <= 0) return FALSE;
+
+		position += received;
+		bytes -= received;
+	}
+	return TRUE;
+}
+
+/*
+ * Send 64-Bit Words Over a Socket in Network Byte Order.
+ * PARAM: connection is a connected SOCKET.
+ * PARAM: words is an array of words, or of doubles IF is_double is TRUE.
+ * PARAM: count is the number of words.
+ * PARAM: is_double is TRUE IF words holds doubles, which are sent as their bits.
+ * PRE: NONE
+ * POST: words written to the socket.
+ * RETURN: TRUE IF every word was sent
+ *          OTHERWISE FALSE
+ */
+static int sendWords(SOCKET connection, const void* words, size_t count, int is_double) {
+	/* Local Variables */
+	unsigned char buffer[WORD_BATCH * sizeof(uint64_t)];
+	const unsigned char *position = (const unsigned char*)words;
+	uint64_t word = 0;
+
+	size_t batch = 0;
+	size_t index = 0;
+	int byte = 0;
+
+	while (count) {
+		batch = count < WORD_BATCH ? count : WORD_BATCH;
+
+		for (index = 0; index < batch; index++) {
+			if (is_double) memcpy(&word, position + index * sizeof(double), sizeof(word));
+			else word = ((const uint64_t*)position)[index];
+
+			for (byte = 0; byte < (int)sizeof(word); byte++) buffer[index * sizeof(word) + byte] = (unsigned char)(word >> (56 - 8 * byte));
+		}
+		if (!sendMessage(connection, buffer, batch * sizeof(uint64_t))) return FALSE;
+
+		position += batch * sizeof(uint64_t);
+		count -= batch;
+	}
+	return TRUE;
+}
+
+/*
+ * Receive 64-Bit Words in Network Byte Order From a Socket.
+ * PARAM: connection is a connected SOCKET.
+ * PARAM: words is an array receiving the words, or the doubles IF is_double is TRUE.
+ * PARAM: count is the number of words.
+ * PARAM: is_double is TRUE IF the words are the bits of doubles.
+ * PRE: words holds at least count words.
+ * POST: words read from the socket.
+ * RETURN: TRUE IF every word was received
+ *          OTHERWISE FALSE
+ */
+static int receiveWords(SOCKET connection, void* words, size_t count, int is_double) {
+	/* Local Variables */
+	unsigned char buffer[WORD_BATCH * sizeof(uint64_t)];
+	unsigned char *position = (unsigned char*)words;
+	uint64_t word = 0;
+
+	size_t batch = 0;
+	size_t index = 0;
+	int byte = 0;
+
+	while (count) {
+		batch = count < WORD_BATCH ? count : WORD_BATCH;
+		if (!receiveMessage(connection, buffer, batch * sizeof(uint64_t))) return FALSE;
+
+		for (index = 0; index < batch; index++) {
+			word = 0;
+			for (byte = 0; byte < (int)sizeof(word); byte++) word = (word << 8) | buffer[index * sizeof(word) + byte];
+
+			if (is_double) memcpy(position + index * sizeof(double), &word, sizeof(word));
+			else ((uint64_t*)position)[index] = word;
+		}
+
+		position += batch * sizeof(uint64_t);
+		count -= batch;
+	}
+	return TRUE;
+}
+
+/*
+ * Print Error Message to Standard Error and Exit a Worker Process.
+ *  Note: Unlike handleError, Workers Do Not Pause as They Have No Console.
+ * PARAM: message is a char array to print to screen.
+ * PRE: error in worker process.
+ * POST: error message printed to stderr.
+ * RETURN: VOID
+ */
+static void handleWorkerError(char* message) {
+	fprintf(stderr, "%s", message);
+	exit(TRUE);
+}
+
+/*
+ * Acquire the Path of This Program's Executable.
+ *  Note: The Program May Have Been Started by a Bare Name Found on PATH, so
+ *        program_path is Only Used IF the Operating System Cannot Say.
+ * PARAM: path is the buffer receiving the path.
+ * PARAM: size is the size of the buffer.
+ * PRE: NONE
+ * POST: path holds the executable's path.
+ * RETURN: VOID
+ */
+static void resolveProgramPath(char* path, size_t size) {
+#ifdef _WIN32
+	DWORD length = GetModuleFileNameA(NULL, path, (DWORD)size);
+	if (length && length < size) return;
+#else
+	ssize_t length = readlink("/proc/self/exe", path, size - 1);
+	if (length > 0) {
+		path[length] = '\0';
+		return;
+	}
+#endif
+
+	snprintf(path, size, "%s", program_path);
+}
+
+/*
+ * Start a Worker Process on This Host.
+ * PARAM: path is the path of this program returned by resolveProgramPath.
+ * PRE: NONE
+ * POST: worker process started in the background.
+ * RETURN: process handle or identifier of the worker; ERROR on failure.
+ */
+static intptr_t spawnWorker(char* path) {
+	/* Local Variables */
+	intptr_t worker = ERROR;
+
+#ifdef _WIN32
+	worker = _spawnl(_P_NOWAIT, path, path, WORKER_MODE, COORDINATOR_HOST, COORDINATOR_PORT, NULL);
+#else
+	worker = fork();
+	if (worker == 0) {
+		execl(path, path, WORKER_MODE, COORDINATOR_HOST, COORDINATOR_PORT, (char*)NULL);
+
+		/* Search PATH Like the Shell IF the Executable Could Not Be Found. */
+		execlp(program_path, program_path, WORKER_MODE, COORDINATOR_HOST, COORDINATOR_PORT, (char*)NULL);
+		_exit(TRUE);
+	}
+#endif
+
+	return worker;
+}
+
+/*
+ * Determine Whether a Worker Process Started by spawnWorker Has Exited.
+ * PARAM: worker is the value returned by spawnWorker.
+ * PRE: NONE
+ * POST: worker process reaped IF it has exited.
+ * RETURN: TRUE IF the worker has exited
+ *          OTHERWISE FALSE
+ */
+static int hasExited(intptr_t worker) {
+	if (worker == ERROR) return FALSE;
+
+#ifdef _WIN32
+	return WaitForSingleObject((HANDLE)worker, 0) == WAIT_OBJECT_0;
+#else
+	return waitpid((pid_t)worker, NULL, WNOHANG) == (pid_t)worker;
+#endif
+}
+
+/*
+ * Wait For a Worker Process Started by spawnWorker to Exit.
+ * PARAM: worker is the value returned by spawnWorker.
+ * PRE: NONE
+ * POST: worker process reaped.
+ * RETURN: VOID
+ */
+static void waitWorker(intptr_t worker) {
+	if (worker == ERROR) return;
+
+#ifdef _WIN32
+	_cwait(NULL, worker, 0);
+#else
+	waitpid((pid_t)worker, NULL, 0);
+#endif
+}
+
+/*
+ * Accept a Connection, Giving Up After CONNECT_TIMEOUT Seconds.
+ *  Note: Started Processes Are Checked Every Second, so a Worker Which Fails to
+ *        Start is Reported Instead of Waited For.
+ * PARAM: listener is a listening SOCKET.
+ * PARAM: address is a pointer receiving the address of the connecting host.
+ * PARAM: processes is an array of workers returned by spawnWorker, or NULL.
+ * PARAM: num_processes is the number of workers in processes.
+ * PARAM: exited is a pointer receiving TRUE IF a started worker exited first.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: connected SOCKET; INVALID_SOCKET on timeout or IF a worker exited.
+ */
+static SOCKET acceptConnection(SOCKET listener, struct sockaddr_in* address, intptr_t* processes, int num_processes, int* exited) {
+	/* Local Variables */
+	fd_set ready;
+	struct timeval timeout;
+	socklen_t address_size = sizeof(*address);
+
+	int waited = 0;
+	int process = 0;
+
+	*exited = FALSE;
+	for (waited = 0; waited < CONNECT_TIMEOUT; waited++) {
+		FD_ZERO(&ready);
+		FD_SET(listener, &ready);
+		timeout.tv_sec = 1;
+		timeout.tv_usec = 0;
+
+		if (select((int)listener + 1, &ready, NULL, NULL, &timeout) > 0) return accept(listener, (struct sockaddr*)address, &address_size);
+
+		for (process = 0; process < num_processes; process++) {
+			if (hasExited(processes[process])) {
+				*exited = TRUE;
+				return INVALID_SOCKET;
+			}
+		}
+	}
+
+	return INVALID_SOCKET;
+}
+
+/*
+ * Limit How Long a Read From a Socket May Block.
+ *  Note: Handshakes Are Timed so a Host Which Connects and Sends Nothing Cannot
+ *        Stall Registration. The Limit is Cleared Once the Handshake is Done, as
+ *        a Worker May Take Far Longer Than That to Load its Rows.
+ * PARAM: connection is a connected SOCKET.
+ * PARAM: seconds is the longest a read may block, or 0 for no limit.
+ * PRE: NONE
+ * POST: receive timeout of the socket is set.
+ * RETURN: VOID
+ */
+static void setReceiveTimeout(SOCKET connection, int seconds) {
+#ifdef _WIN32
+	/* Local Variables */
+	DWORD timeout = (DWORD)seconds * 1000;
+#else
+	/* Local Variables */
+	struct timeval timeout;
+
+	timeout.tv_sec = seconds;
+	timeout.tv_usec = 0;
+#endif
+
+	setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+}
+
+/*
+ * Find the Byte Offsets at Which Rows of the Web File Start.
+ * PARAM: web_file is a pointer to a filestream opened in binary mode.
+ * PARAM: rows is an array of row numbers in ascending order.
+ * PARAM: count is the number of rows.
+ * PARAM: offsets is an array receiving the byte offset of each row.
+ * PRE: web_file is a pointer to a correctly-formatted matrix file.
+ * POST: web_file's internal pointer is set to beginning of stream.
+ * RETURN: VOID
+ */
+static void findRowOffsets(FILE* web_file, size_t* rows, int count, long long* offsets) {
+	/* Local Variables */
+	unsigned char file_buffer[OUTPUT_BUFF];
+	long long position = 0;
+	size_t num_read = 0;
+	size_t index = 0;
+	size_t row = 0;
+	int next = 0;
+
+	while (next < count && rows[next] == 0) offsets[next++] = 0;
+
+	while (next < count && (num_read = fread(file_buffer, sizeof(unsigned char), OUTPUT_BUFF, web_file)) > 0) {
+		for (index = 0; index < num_read && next < count; index++) {
+			if (file_buffer[index] != '\n') continue;
+
+			row++;
+			while (next < count && rows[next] == row) offsets[next++] = position + index + 1;
+		}
+		position += num_read;
+	}
+
+	/* Rows Past the Last Line Start at the End of the File. */
+	while (next < count) offsets[next++] = position;
+
+	fseek(web_file, FALSE, SEEK_SET);
+}
+
+/*
+ * Loads the Workers to Wait For From the Worker File.
+ * PARAM: hosts is a pointer to the WorkerHosts receiving the workers.
+ * PRE: sockets are started.
+ * POST: hosts lists the workers in the worker file, or DEFAULT_WORKERS
+ *       workers on this host IF there is no worker file.
+ * RETURN: VOID
+ */
+void loadWorkerHosts(WorkerHosts* hosts) {
+	/* Local Variables */
+	FILE *worker_file = NULL;
+	char host[INPUT_BUFF];
+	struct addrinfo hints;
+	struct addrinfo *address = NULL;
+
+	memset(hosts, 0, sizeof(*hosts));
+
+	if (fopen_s(&worker_file, WORKER_FILE, "r") || !worker_file) {
+		hosts->num_workers = DEFAULT_WORKERS;
+		hosts->num_local = DEFAULT_WORKERS;
+		return;
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+
+	while (fscanf(worker_file, "%127s", host) == TRUE) {
+		if (hosts->num_workers == MAX_WORKERS) handleError("\nToo Many Workers in Worker File.\n");
+		hosts->num_workers++;
+
+		if (!strcmp(host, LOCAL_HOST)) {
+			hosts->num_local++;
+			continue;
+		}
+
+		if (getaddrinfo(host, NULL, &hints, &address)) handleError("\nUnable To Resolve Worker Host:\n");
+		hosts->remote_address[hosts->num_remote++] = ntohl(((struct sockaddr_in*)address->ai_addr)->sin_addr.s_addr);
+		freeaddrinfo(address);
+	}
+	fclose(worker_file);
+
+	if (!hosts->num_workers) handleError("\nNo Workers in Worker File.\n");
+}
+
+/*
+ * Determine Whether a Connecting Worker May Take One of the Listed Places.
+ *  Note: Workers Started on This Host Connect Through the Loopback Address.
+ * PARAM: hosts is a pointer to WorkerHosts returned by loadWorkerHosts.
+ * PARAM: address is the IPv4 address of the worker, in host byte order.
+ * PARAM: num_local is a pointer to the number of local places taken.
+ * PRE: NONE
+ * POST: place of the worker is taken IF it was listed.
+ * RETURN: TRUE IF the worker was listed
+ *          OTHERWISE FALSE
+ */
+static int claimWorker(WorkerHosts* hosts, uint32_t address, int* num_local) {
+	/* Local Variables */
+	int remote = 0;
+
+	if ((address >> 24) == 127) {
+		if (*num_local == hosts->num_local) return FALSE;
+		(*num_local)++;
+		return TRUE;
+	}
+
+	for (remote = 0; remote < hosts->num_remote; remote++) {
+		if (!hosts->remote_claimed[remote] && hosts->remote_address[remote] == address) {
+			hosts->remote_claimed[remote] = TRUE;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+ * Calculate the PageRank With the Power Method Across Worker Processes.
+ *  Note: Each Worker Owns a Range of Pages and Sends Its Peers Only the Shares
+ *        of Its Pages That Link Into Their Ranges. The Coordinator Only Reduces
+ *        the Residual, Dangling Rank and Total Rank, and Gathers the Result.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for distributed power method.
+ * POST: pagerank stored in MATLAB array x.
+ * RETURN: VOID
+ */
+void calculateDistributed(Engine* ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	FILE *web_file = NULL;
+	WorkerHosts hosts;
+	unsigned long long key = 0;
+	size_t dimension = 0;
+	long long file_size = 0;
+
+	SOCKET listener = INVALID_SOCKET;
+	SOCKET connection = INVALID_SOCKET;
+	SOCKET workers[MAX_WORKERS];
+	intptr_t processes[MAX_WORKERS];
+	struct addrinfo hints;
+	struct addrinfo *address = NULL;
+	struct sockaddr_in worker_address;
+	char path[OUTPUT_BUFF];
+	int reuse = TRUE;
+	int exited = FALSE;
+	int num_local = 0;
+
+	size_t first[MAX_WORKERS + 1];
+	long long row_offset[MAX_WORKERS];
+	uint64_t registration[3];
+	uint64_t assignment[5];
+	uint64_t peer_table[2 * MAX_WORKERS];
+	uint32_t peer = 0;
+	double check = 0;
+
+	double *pagerank = NULL;
+	double reduction[3];
+	double control[2];
+	double residual = 0;
+	double dangling = 0;
+	double total = 0;
+
+	int rank = 0;
+	int accepted = FALSE;
+	int iterations = 0;
+	int rounds = 0;
+	int converged = FALSE;
+	size_t page = 0;
+	clock_t start = 0;
+
+	fprintf(stdout, "\nDistributed Power Method Calculation...\n");
+
+#ifdef _WIN32
+	WSADATA wsa_data;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa_data)) handleError("\nUnable To Start Windows Sockets.\n");
+#endif
+
+	loadWorkerHosts(&hosts);
+
+	/* Try to Open and Parse the Web File Containing the Matrix. */
+	if (fopen_s(&web_file, WEB, "r")) handleError("\nUnable To Open Web File:\n");
+	else if (!web_file) handleError("\nUnable To Parse Web File:\n");
+
+	dimension = getDimension(web_file);
+	key = hashWeb(web_file);
+	fclose(web_file);
+
+	pagerank = (double*)malloc((dimension + 1) * sizeof(double));
+	if (!pagerank) handleError("\nUnable To Allocate Memory For PageRank.\n");
+
+	/* Workers Start From the Checkpoint, Which Needs No Workers at All IF it Had Converged. */
+	for (page = 0; page < dimension; page++) pagerank[page] = 1;
+	if (loadCheckpoint(DISTRIBUTED, key, pagerank, dimension, NULL, &iterations) == CHECKPOINT_COMPLETE) {
+		storePageRank(ep, pagerank, dimension);
+#ifdef _WIN32
+		WSACleanup();
+#endif
+		free(pagerank);
+		return;
+	}
+
+	for (rank = 0; rank <= hosts.num_workers; rank++) first[rank] = dimension * rank / hosts.num_workers;
+
+	/* Workers Seek Straight to Their First Row, so Offsets Are Found in Binary Mode. */
+	if (fopen_s(&web_file, WEB, "rb") || !web_file) handleError("\nUnable To Open Web File:\n");
+	findRowOffsets(web_file, first, hosts.num_workers, row_offset);
+	if (SEEK_FILE(web_file, 0, SEEK_END)) handleError("\nUnable To Parse Web File:\n");
+	file_size = (long long)TELL_FILE(web_file);
+	fclose(web_file);
+
+	/* Listen on All Interfaces Only IF Workers Run on Other Hosts. */
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+
+	if (getaddrinfo(hosts.num_remote ? NULL : COORDINATOR_HOST, COORDINATOR_PORT, &hints, &address)) handleError("\nUnable To Resolve Coordinator Address.\n");
+
+	listener = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+	if (listener == INVALID_SOCKET) handleError("\nUnable To Create Coordinator Socket.\n");
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse, sizeof(reuse));
+
+	if (bind(listener, address->ai_addr, (int)address->ai_addrlen) || listen(listener, MAX_WORKERS))
+		handleError("\nUnable To Listen For Workers.\n");
+	freeaddrinfo(address);
+
+	resolveProgramPath(path, OUTPUT_BUFF);
+	for (rank = 0; rank < hosts.num_local; rank++) {
+		processes[rank] = spawnWorker(path);
+		if (processes[rank] == ERROR) handleError("\nUnable To Start Worker Process.\n");
+	}
+
+	/* Ranks Are Given in the Order Workers Connect. Workers Must Speak This Protocol and Be Listed. */
+	rank = 0;
+	while (rank < hosts.num_workers) {
+		connection = acceptConnection(listener, &worker_address, processes, hosts.num_local, &exited);
+		if (exited) handleError("\nWorker Process Exited Before Connecting.\n");
+		if (connection == INVALID_SOCKET) handleError("\nTimed Out Waiting For Workers.\n");
+
+		peer = ntohl(worker_address.sin_addr.s_addr);
+		setReceiveTimeout(connection, CONNECT_TIMEOUT);
+		accepted = receiveWords(connection, registration, 3, FALSE) && receiveWords(connection, &check, 1, TRUE)
+			&& registration[0] == PROTOCOL_MAGIC && registration[1] == PROTOCOL_VERSION && check == PROTOCOL_CHECK
+			&& claimWorker(&hosts, peer, &num_local);
+
+		if (!accepted) {
+			fprintf(stderr, "\nRejected Worker From an Unlisted Host or Incompatible Build.\n");
+			closesocket(connection);
+			continue;
+		}
+
+		/* Peers Reach Workers on This Host Through the Coordinator's Address. */
+		setReceiveTimeout(connection, 0);
+		workers[rank] = connection;
+		peer_table[2 * rank] = (peer >> 24) == 127 ? 0 : peer;
+		peer_table[2 * rank + 1] = registration[2];
+		rank++;
+	}
+	closesocket(listener);
+
+	for (rank = 0; rank < hosts.num_workers; rank++) {
+		assignment[0] = (uint64_t)rank;
+		assignment[1] = (uint64_t)hosts.num_workers;
+		assignment[2] = (uint64_t)dimension;
+		assignment[3] = (uint64_t)row_offset[rank];
+		assignment[4] = (uint64_t)file_size;
+
+		if (!sendWords(workers[rank], assignment, 5, FALSE) || !sendWords(workers[rank], peer_table, 2 * (size_t)hosts.num_workers, FALSE)
+			|| !sendWords(workers[rank], pagerank + first[rank], first[rank + 1] - first[rank], TRUE))
+			handleError("\nUnable To Send to Worker.\n");
+	}
+
+	/* Iterate Until the Global Residual Shows PageRank Stopped Changing. */
+	start = clock();
+	while (!converged) {
+		residual = 0;
+		dangling = 0;
+		total = 0;
+
+		for (rank = 0; rank < hosts.num_workers; rank++) {
+			if (!receiveWords(workers[rank], reduction, 3, TRUE)) handleError("\nUnable To Receive From Worker.\n");
+
+			residual += reduction[0];
+			dangling += reduction[1];
+			total += reduction[2];
+		}
+
+		/* Workers Report No Change Before Their First Iteration. The Change is Measured Against the Total Rank, as in the Out-of-Core Power Method. */
+		converged = rounds++ && residual <= RANK_TOLERANCE * total;
+		control[0] = converged;
+		control[1] = (DAMPING_FACTOR * dangling + (1 - DAMPING_FACTOR) * total) / dimension;
+
+		for (rank = 0; rank < hosts.num_workers; rank++) {
+			if (!sendWords(workers[rank], control, 2, TRUE)) handleError("\nUnable To Send to Worker.\n");
+		}
+
+		if (!converged) iterations++;
+	}
+
+	/* Gather the Converged PageRank From Each Worker's Range. */
+	for (rank = 0; rank < hosts.num_workers; rank++) {
+		if (!receiveWords(workers[rank], pagerank + first[rank], first[rank + 1] - first[rank], TRUE))
+			handleError("\nUnable To Receive From Worker.\n");
+		closesocket(workers[rank]);
+	}
+
+	fprintf(stdout, "\nDistributed Power Method : %i Workers, %i Iterations In %.6f Seconds\n",
+		hosts.num_workers, iterations, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	saveCheckpoint(DISTRIBUTED, key, pagerank, dimension, iterations, TRUE);
+	storePageRank(ep, pagerank, dimension);
+
+	/* Deallocate Memory. */
+	for (rank = 0; rank < hosts.num_local; rank++) waitWorker(processes[rank]);
+
+#ifdef _WIN32
+	WSACleanup();
+#endif
+
+	free(pagerank);
+}
+
+/*
+ * Compare Two Page Numbers For qsort and bsearch.
+ * PARAM: first is a pointer to an unsigned int.
+ * PARAM: second is a pointer to an unsigned int.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: negative, zero or positive as first is less than, equal to or greater than second.
+ */
+static int comparePages(const void* first, const void* second) {
+	/* Local Variables */
+	unsigned int first_page = *(const unsigned int*)first;
+	unsigned int second_page = *(const unsigned int*)second;
+
+	return (first_page > second_page) - (first_page < second_page);
+}
+
+/*
+ * Acquire the Peer a Worker Exchanges With in One Round.
+ *  Note: Every Pair of Workers Meets in Exactly One Round, and No Worker Meets
+ *        Two Peers in the Same Round, so Blocking Exchanges Cannot Deadlock.
+ * PARAM: rank is the index of the worker.
+ * PARAM: round is the index of the round, less than num_workers.
+ * PARAM: num_workers is the number of workers.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: rank of the peer, which is rank itself IF the worker sits out the round.
+ */
+static int getPartner(int rank, int round, int num_workers) {
+	return ((round - rank) % num_workers + num_workers) % num_workers;
+}
+
+/*
+ * Run a Worker Process Which Owns a Range of Pages.
+ *  Note: The Worker Seeks Straight to its Own Rows of the Web File. Links From
+ *        Other Workers' Pages Are Renumbered to Follow its Own Pages, so Local
+ *        and Received Shares Are Read From One Array.
+ * PARAM: host is the name or address of the coordinator.
+ * PARAM: port is the port the coordinator listens on.
+ * PRE: coordinator is listening; the same web file is readable from the working directory.
+ * POST: worker's range of the pagerank sent to the coordinator.
+ * RETURN: TRUE IF the worker runs as intended
+ *          OTHERWISE FALSE
+ */
+int runWorker(char* host, char* port) {
+	/* Local Variables */
+	FILE *web_file = NULL;
+
+	SOCKET coordinator = INVALID_SOCKET;
+	SOCKET listener = INVALID_SOCKET;
+	SOCKET connection = INVALID_SOCKET;
+	SOCKET peers[MAX_WORKERS];
+	struct addrinfo hints;
+	struct addrinfo *address = NULL;
+	struct sockaddr_in peer_address;
+	socklen_t address_size = sizeof(peer_address);
+	char peer_host[INPUT_BUFF];
+	char peer_port[INPUT_BUFF];
+	uint32_t coordinator_address = 0;
+	uint32_t expected = 0;
+	uint32_t source = 0;
+	int exited = FALSE;
+
+	uint64_t registration[3] = { PROTOCOL_MAGIC, PROTOCOL_VERSION, 0 };
+	uint64_t assignment[5];
+	uint64_t peer_table[2 * MAX_WORKERS];
+	uint64_t word = 0;
+	uint64_t *words = NULL;
+	double check = PROTOCOL_CHECK;
+
+	int rank = 0;
+	int num_workers = 0;
+	int peer = 0;
+	int round = 0;
+	size_t dimension = 0;
+	size_t first = 0;
+	size_t last = 0;
+	size_t num_pages = 0;
+	size_t owner_first[MAX_WORKERS + 1];
+
+	size_t num_edges = 0;
+	WebLinks links = { 0, 0, NULL, NULL };
+	unsigned int *sources = NULL;
+	double *weights = NULL;
+	size_t *in_start = NULL;
+
+	/* Pages of Other Workers Linking Into This Worker's Range, Sorted so Each Peer's Pages Are Adjacent. */
+	unsigned int *needed = NULL;
+	unsigned int *slot = NULL;
+	double *needed_weight = NULL;
+	size_t num_needed = 0;
+	size_t needed_start[MAX_WORKERS + 1];
+
+	/* Pages of This Worker Which Each Peer Needs. */
+	unsigned int *send_pages[MAX_WORKERS];
+	size_t send_count[MAX_WORKERS];
+	double *outgoing = NULL;
+	size_t max_send = 0;
+
+	WebMatrix *matrix = NULL;
+	WebKernels kernels;
+
+	double *out_weight = NULL;
+	double *x_curr = NULL;
+	double *x_next = NULL;
+	double *swap = NULL;
+	double *values = NULL;
+	double *received_weight = NULL;
+	double reduction[3] = { 0, 0, 0 };
+	double control[2] = { 0, 0 };
+	double link = 0;
+
+	size_t row = 0;
+	size_t page = 0;
+	size_t edge = 0;
+	size_t index = 0;
+
+#ifdef _WIN32
+	WSADATA wsa_data;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa_data)) handleWorkerError("\nUnable To Start Windows Sockets.\n");
+#endif
+
+	/* Listen For Peers With Higher Ranks on Any Free Port. */
+	memset(&peer_address, 0, sizeof(peer_address));
+	peer_address.sin_family = AF_INET;
+	peer_address.sin_addr.s_addr = htonl(INADDR_ANY);
+	peer_address.sin_port = 0;
+
+	listener = socket(AF_INET, SOCK_STREAM, 0);
+	if (listener == INVALID_SOCKET || bind(listener, (struct sockaddr*)&peer_address, sizeof(peer_address)) || listen(listener, MAX_WORKERS)
+		|| getsockname(listener, (struct sockaddr*)&peer_address, &address_size))
+		handleWorkerError("\nUnable To Listen For Peers.\n");
+	registration[2] = ntohs(peer_address.sin_port);
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+
+	if (getaddrinfo(host, port, &hints, &address)) handleWorkerError("\nUnable To Resolve Coordinator Address.\n");
+
+	coordinator = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+	if (coordinator == INVALID_SOCKET || connect(coordinator, address->ai_addr, (int)address->ai_addrlen))
+		handleWorkerError("\nUnable To Connect to Coordinator.\n");
+	coordinator_address = ntohl(((struct sockaddr_in*)address->ai_addr)->sin_addr.s_addr);
+	freeaddrinfo(address);
+
+	if (!sendWords(coordinator, registration, 3, FALSE) || !sendWords(coordinator, &check, 1, TRUE)
+		|| !receiveWords(coordinator, assignment, 5, FALSE))
+		handleWorkerError("\nUnable To Register With Coordinator.\n");
+
+	rank = (int)assignment[0];
+	num_workers = (int)assignment[1];
+	dimension = (size_t)assignment[2];
+	if (num_workers < 1 || num_workers > MAX_WORKERS || rank >= num_workers || !receiveWords(coordinator, peer_table, 2 * (size_t)num_workers, FALSE))
+		handleWorkerError("\nUnable To Register With Coordinator.\n");
+
+	for (peer = 0; peer <= num_workers; peer++) owner_first[peer] = dimension * peer / num_workers;
+	first = owner_first[rank];
+	last = owner_first[rank + 1];
+	num_pages = last - first;
+
+	/* The Coordinator Sends the Starting PageRank Before Any Peer Connects. */
+	x_curr = (double*)malloc((num_pages + 1) * sizeof(double));
+	if (!x_curr) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+	if (!receiveWords(coordinator, x_curr, num_pages, TRUE)) handleWorkerError("\nUnable To Receive From Coordinator.\n");
+
+	/* Connect to Peers With Lower Ranks, Then Accept Peers With Higher Ranks. */
+	for (peer = 0; peer < num_workers; peer++) peers[peer] = INVALID_SOCKET;
+	for (peer = 0; peer < rank; peer++) {
+		if (peer_table[2 * peer]) {
+			snprintf(peer_host, INPUT_BUFF, "%u.%u.%u.%u", (unsigned int)(peer_table[2 * peer] >> 24) & 0xFF, (unsigned int)(peer_table[2 * peer] >> 16) & 0xFF,
+				(unsigned int)(peer_table[2 * peer] >> 8) & 0xFF, (unsigned int)peer_table[2 * peer] & 0xFF);
+		}
+		else snprintf(peer_host, INPUT_BUFF, "%s", host);
+		snprintf(peer_port, INPUT_BUFF, "%u", (unsigned int)peer_table[2 * peer + 1]);
+
+		word = (uint64_t)rank;
+		if (getaddrinfo(peer_host, peer_port, &hints, &address)) handleWorkerError("\nUnable To Resolve Peer Address.\n");
+
+		peers[peer] = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+		if (peers[peer] == INVALID_SOCKET || connect(peers[peer], address->ai_addr, (int)address->ai_addrlen) || !sendWords(peers[peer], &word, 1, FALSE))
+			handleWorkerError("\nUnable To Connect to Peer.\n");
+		freeaddrinfo(address);
+	}
+	peer = rank + 1;
+	while (peer < num_workers) {
+		connection = acceptConnection(listener, &peer_address, NULL, 0, &exited);
+		if (connection == INVALID_SOCKET) handleWorkerError("\nTimed Out Waiting For Peers.\n");
+
+		/* A Peer Must Connect From the Address the Coordinator Registered For its Rank. Peers on
+		   the Coordinator's Host Are Registered as 0 and May Also Connect Over Loopback. */
+		setReceiveTimeout(connection, CONNECT_TIMEOUT);
+		source = ntohl(peer_address.sin_addr.s_addr);
+		if (!receiveWords(connection, &word, 1, FALSE) || word <= (uint64_t)rank || word >= (uint64_t)num_workers || peers[word] != INVALID_SOCKET) {
+			fprintf(stderr, "\nRejected Peer With an Invalid Rank.\n");
+			closesocket(connection);
+			continue;
+		}
+
+		expected = peer_table[2 * word] ? (uint32_t)peer_table[2 * word] : coordinator_address;
+		if (source != expected && (peer_table[2 * word] || (source >> 24) != 127)) {
+			fprintf(stderr, "\nRejected Peer From an Address Not Registered For its Rank.\n");
+			closesocket(connection);
+			continue;
+		}
+
+		setReceiveTimeout(connection, 0);
+		peers[word] = connection;
+		peer++;
+	}
+	closesocket(listener);
+
+	in_start = (size_t*)calloc(num_pages + 1, sizeof(size_t));
+	out_weight = (double*)calloc(num_pages + 1, sizeof(double));
+	if (!in_start || !out_weight) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+
+	/* The Coordinator's Offsets Only Apply to an Identical Web File. */
+	if (fopen_s(&web_file, WEB, "rb") || !web_file) handleWorkerError("\nUnable To Open Web File:\n");
+	if (SEEK_FILE(web_file, 0, SEEK_END) || (long long)TELL_FILE(web_file) != (long long)assignment[4] || SEEK_FILE(web_file, (long long)assignment[3], SEEK_SET))
+		handleWorkerError("\nWeb File Differs From the Coordinator's.\n");
+
+	/* Read Only the Rows of This Worker's Pages. */
+	for (row = first; row < last; row++) {
+		readWebRow(web_file, dimension, &links, handleWorkerError);
+		in_start[row - first + 1] = links.num_links;
+	}
+	fclose(web_file);
+
+	num_edges = links.num_links;
+	sources = links.source;
+	weights = links.weight;
+
+	/* Collect the Distinct Pages of Other Workers Which Link Into This Range. */
+	needed = (unsigned int*)malloc((num_edges + 1) * sizeof(unsigned int));
+	if (!needed) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+
+	for (edge = 0; edge < num_edges; edge++) {
+		if (sources[edge] < first || sources[edge] >= last) needed[num_needed++] = sources[edge];
+	}
+	qsort(needed, num_needed, sizeof(unsigned int), comparePages);
+	for (edge = 0, index = 0; edge < num_needed; edge++) {
+		if (!index || needed[index - 1] != needed[edge]) needed[index++] = needed[edge];
+	}
+	num_needed = index;
+
+	/* Renumber Links and Sum the Weights This Worker's Rows Give Each Linking Page. */
+	needed_weight = (double*)calloc(num_needed + 1, sizeof(double));
+	if (!needed_weight) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+
+	for (edge = 0; edge < num_edges; edge++) {
+		link = weights ? weights[edge] : 1;
+
+		if (sources[edge] >= first && sources[edge] < last) {
+			sources[edge] -= (unsigned int)first;
+			out_weight[sources[edge]] += link;
+		}
+		else {
+			slot = (unsigned int*)bsearch(&sources[edge], needed, num_needed, sizeof(unsigned int), comparePages);
+			needed_weight[slot - needed] += link;
+			sources[edge] = (unsigned int)(num_pages + (slot - needed));
+		}
+	}
+
+	for (peer = 0, index = 0; peer < num_workers; peer++) {
+		needed_start[peer] = index;
+		while (index < num_needed && needed[index] < owner_first[peer + 1]) index++;
+	}
+	needed_start[num_workers] = num_needed;
+
+	/* Tell Each Peer Which of its Pages This Worker Needs, With Their Partial Weight Sums. */
+	words = (uint64_t*)malloc((num_needed + 1) * sizeof(uint64_t));
+	if (!words) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+	for (index = 0; index < num_needed; index++) words[index] = needed[index];
+
+	for (round = 0; round < num_workers; round++) {
+		peer = getPartner(rank, round, num_workers);
+		send_pages[peer] = NULL;
+		send_count[peer] = 0;
+		if (peer == rank) continue;
+
+		/* The Lower Rank Sends First. */
+		for (index = 0; index < 2; index++) {
+			if ((index == 0) == (rank < peer)) {
+				word = needed_start[peer + 1] - needed_start[peer];
+				if (!sendWords(peers[peer], &word, 1, FALSE) || !sendWords(peers[peer], words + needed_start[peer], (size_t)word, FALSE)
+					|| !sendWords(peers[peer], needed_weight + needed_start[peer], (size_t)word, TRUE))
+					handleWorkerError("\nUnable To Send to Peer.\n");
+			}
+			else {
+				if (!receiveWords(peers[peer], &word, 1, FALSE) || word > num_pages) handleWorkerError("\nUnable To Receive From Peer.\n");
+				send_count[peer] = (size_t)word;
+
+				send_pages[peer] = (unsigned int*)malloc((send_count[peer] + 1) * sizeof(unsigned int));
+				received_weight = (double*)malloc((send_count[peer] + 1) * sizeof(double));
+				words = (uint64_t*)realloc(words, (num_needed + send_count[peer] + 1) * sizeof(uint64_t));
+				if (!send_pages[peer] || !received_weight || !words) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+
+				if (!receiveWords(peers[peer], words + num_needed, send_count[peer], FALSE) || !receiveWords(peers[peer], received_weight, send_count[peer], TRUE))
+					handleWorkerError("\nUnable To Receive From Peer.\n");
+
+				for (page = 0; page < send_count[peer]; page++) {
+					if (words[num_needed + page] < first || words[num_needed + page] >= last) handleWorkerError("\nInvalid Page From Peer.\n");
+					send_pages[peer][page] = (unsigned int)(words[num_needed + page] - first);
+					out_weight[send_pages[peer][page]] += received_weight[page];
+				}
+				if (send_count[peer] > max_send) max_send = send_count[peer];
+
+				free(received_weight);
+			}
+		}
+	}
+
+	free(words);
+	free(needed);
+	free(needed_weight);
+
+	values = (double*)malloc((num_pages + num_needed + 1) * sizeof(double));
+	outgoing = (double*)malloc((max_send + 1) * sizeof(double));
+	x_next = (double*)malloc((num_pages + 1) * sizeof(double));
+	if (!values || !outgoing || !x_next) handleWorkerError("\nUnable To Allocate Worker Memory.\n");
+
+	/* Renumbered Sources Index values, Which Holds Local and Received Shares. */
+	matrix = buildWebMatrix(num_pages, num_edges, in_start, sources, weights);
+	kernels = getKernels(matrix, 1);
+
+	while (TRUE) {
+		/* Share of Rank Each Page Passes Along Each Link, Per Unit Weight. */
+		reduction[1] = 0;
+		reduction[2] = 0;
+		for (page = 0; page < num_pages; page++) {
+			reduction[2] += x_curr[page];
+			if (out_weight[page]) values[page] = DAMPING_FACTOR * x_curr[page] / out_weight[page];
+			else {
+				values[page] = 0;
+				reduction[1] += x_curr[page];
+			}
+		}
+
+		/* Only Scalars Pass Through the Coordinator. */
+		if (!sendWords(coordinator, reduction, 3, TRUE) || !receiveWords(coordinator, control, 2, TRUE))
+			handleWorkerError("\nUnable To Reach Coordinator.\n");
+		if (control[0]) break;
+
+		/* Exchange Boundary Shares With Each Peer. */
+		for (round = 0; round < num_workers; round++) {
+			peer = getPartner(rank, round, num_workers);
+			if (peer == rank) continue;
+
+			for (index = 0; index < 2; index++) {
+				if ((index == 0) == (rank < peer)) {
+					for (page = 0; page < send_count[peer]; page++) outgoing[page] = values[send_pages[peer][page]];
+					if (!sendWords(peers[peer], outgoing, send_count[peer], TRUE)) handleWorkerError("\nUnable To Send to Peer.\n");
+				}
+				else if (!receiveWords(peers[peer], values + num_pages + needed_start[peer], needed_start[peer + 1] - needed_start[peer], TRUE))
+					handleWorkerError("\nUnable To Receive From Peer.\n");
+			}
+		}
+
+		/* Every Page Receives the Same Teleport, so No Distribution is Given. */
+		kernels.spmv(matrix, values, &control[1], NULL, x_next, 0, num_pages);
+
+		reduction[0] = 0;
+		for (page = 0; page < num_pages; page++) reduction[0] += fabs(x_next[page] - x_curr[page]);
+		swap = x_curr; x_curr = x_next; x_next = swap;
+	}
+
+	if (!sendWords(coordinator, x_curr, num_pages, TRUE)) handleWorkerError("\nUnable To Send to Coordinator.\n");
+	closesocket(coordinator);
+
+	for (peer = 0; peer < num_workers; peer++) {
+		if (peer != rank) closesocket(peers[peer]);
+		free(send_pages[peer]);
+	}
+
+#ifdef _WIN32
+	WSACleanup();
+#endif
+
+	free(sources);
+	free(weights);
+	free(in_start);
+	free(out_weight);
+	freeWebMatrix(matrix);
+	free(x_curr);
+	free(x_next);
+	free(values);
+	free(outgoing);
+
+	return TRUE;
+}
@@ -0,0 +1,80 @@
+/*
+ * File: distributed.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "websolver.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+#define WORKER_MODE "worker"
+
+#define COORDINATOR_HOST "127.0.0.1"
+#define COORDINATOR_PORT "25900"
+
+/* Each Line Names the Host of One Worker. Workers on LOCAL_HOST Are Started by the
+   Coordinator. Others Are Started on Their Host With : pagerank worker <coordinator> <port> */
+#define WORKER_FILE "workers.txt"
+#define LOCAL_HOST "localhost"
+
+/* Workers Started on This Host When There is No Worker File. */
+#define DEFAULT_WORKERS 4
+#define MAX_WORKERS 64
+
+/* Seconds to Wait For Workers and Peers to Connect. */
+#define CONNECT_TIMEOUT 60
+
+/* Messages Are 64-Bit Words in Network Byte Order. Doubles Are Sent as Their IEEE-754 Bits,
+   Which Workers Confirm by Sending PROTOCOL_CHECK When They Register. */
+#define PROTOCOL_MAGIC 0x5052444BULL
+#define PROTOCOL_VERSION 3
+#define PROTOCOL_CHECK 1.5
+
+/* Words Converted to Network Byte Order at Once. */
+#define WORD_BATCH 512
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Workers Listed in the Worker File. Remote Workers Are Only Accepted
+   From the IPv4 Addresses of Their Listed Hosts, in Host Byte Order. */
+typedef struct {
+	int num_workers;
+	int num_local;
+	int num_remote;
+	uint32_t remote_address[MAX_WORKERS];
+	int remote_claimed[MAX_WORKERS];
+} WorkerHosts;
+
+/***************************/
+/**** Declare Variables ****/
+/***************************/
+
+extern char* program_path;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+void loadWorkerHosts(WorkerHosts* hosts);
+void calculateDistributed(Engine* ep);
+int runWorker(char* host, char* port);
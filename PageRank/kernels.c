@@ -0,0 +1,236 @@
+/*
+ * File: kernels.c
+ * Purpose: Builds the Specialized Kernels of the Native Solvers and Selects Those
+ * 			Matching a Web Once, so Their Loops Carry No Per-Link Branches.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* Include Header */
+#include "kernels.h"
+#include "pagerank.h"
+
+/* Name of a Kernel in the Specialization Being Defined. */
+#define KERNEL_PASTE(name, suffix) name##suffix
+#define KERNEL_EXPAND(name, suffix) KERNEL_PASTE(name, suffix)
+#define KERNEL_NAME(name) KERNEL_EXPAND(name, KERNEL_SUFFIX)
+
+/* 32-Bit Offsets. Streamed Blocks Are Only Read Unweighted or With Double Weights. */
+#define KERNEL_OFFSET_TYPE unsigned int
+#define KERNEL_SUFFIX _32_pattern
+#define KERNEL_STREAM
+#include "kerneltemplate.h"
+
+#define KERNEL_OFFSET_TYPE unsigned int
+#define KERNEL_VALUE_TYPE float
+#define KERNEL_SUFFIX _32_float
+#include "kerneltemplate.h"
+
+#define KERNEL_OFFSET_TYPE unsigned int
+#define KERNEL_VALUE_TYPE double
+#define KERNEL_SUFFIX _32_double
+#define KERNEL_STREAM
+#include "kerneltemplate.h"
+
+/* 64-Bit Offsets. */
+#define KERNEL_OFFSET_TYPE unsigned long long
+#define KERNEL_SUFFIX _64_pattern
+#include "kerneltemplate.h"
+
+#define KERNEL_OFFSET_TYPE unsigned long long
+#define KERNEL_VALUE_TYPE float
+#define KERNEL_SUFFIX _64_float
+#include "kerneltemplate.h"
+
+#define KERNEL_OFFSET_TYPE unsigned long long
+#define KERNEL_VALUE_TYPE double
+#define KERNEL_SUFFIX _64_double
+#include "kerneltemplate.h"
+
+/* Specializations Indexed by KERNEL_OFFSET, KERNEL_VALUE and getWidthIndex of the Width. */
+#define KERNEL_WIDTHS(suffix) { spmv1##suffix, spmv2##suffix, spmv4##suffix, spmv8##suffix, spmv12##suffix, spmv16##suffix }
+
+static const SpmvKernel spmv_kernels[2][3][6] = {
+	{ KERNEL_WIDTHS(_32_pattern), KERNEL_WIDTHS(_32_float), KERNEL_WIDTHS(_32_double) },
+	{ KERNEL_WIDTHS(_64_pattern), KERNEL_WIDTHS(_64_float), KERNEL_WIDTHS(_64_double) }
+};
+
+static const SweepKernel sweep_kernels[2][3] = {
+	{ sweep_32_pattern, sweep_32_float, sweep_32_double },
+	{ sweep_64_pattern, sweep_64_float, sweep_64_double }
+};
+
+/* Indexed by Whether the Streamed Web is Weighted. */
+static const StreamKernel stream_kernels[2] = { stream_32_pattern, stream_32_double };
+
+/*
+ * Builds Incoming Links in the Narrowest Offset and Value Types.
+ *  Note: Offsets Are 32-Bit Unless There Are More Than KERNEL_OFFSET_LIMIT Links.
+ *        Weights Are Stored as Float When Every Weight is Exactly a Float, Such as
+ *        Small Whole Numbers, Which Halves the Weights Read Per Iteration.
+ * PARAM: dimension is the number of pages whose incoming links are given.
+ * PARAM: num_edges is the number of links.
+ * PARAM: in_start is the array of offsets of each page's first incoming link.
+ * PARAM: in_source is the array of the source of each link.
+ * PARAM: in_weight is the array of the weight of each link, or NULL IF every link has weight one.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: dynamically allocated WebMatrix, valid until in_source and in_weight are freed.
+ */
+WebMatrix* buildWebMatrix(size_t dimension, size_t num_edges, size_t* in_start, unsigned int* in_source, double* in_weight) {
+	/* Local Variables */
+	WebMatrix *matrix = NULL;
+
+	unsigned int *start_32 = NULL;
+	unsigned long long *start_64 = NULL;
+	float *weight_float = NULL;
+
+	size_t page = 0;
+	size_t edge = 0;
+	int exact = TRUE;
+
+	matrix = (WebMatrix*)calloc(1, sizeof(WebMatrix));
+	if (!matrix) handleError("\nUnable To Allocate Memory For Web Matrix.\n");
+
+	matrix->dimension = dimension;
+	matrix->offset_type = num_edges > KERNEL_OFFSET_LIMIT ? OFFSET_64 : OFFSET_32;
+	matrix->source = in_source;
+
+	if (matrix->offset_type == OFFSET_32) {
+		start_32 = (unsigned int*)malloc((dimension + 1) * sizeof(unsigned int));
+		if (!start_32) handleError("\nUnable To Allocate Memory For Web Matrix.\n");
+
+		for (page = 0; page <= dimension; page++) start_32[page] = (unsigned int)in_start[page];
+
+		matrix->start = matrix->buffers[0] = start_32;
+	}
+	else {
+		start_64 = (unsigned long long*)malloc((dimension + 1) * sizeof(unsigned long long));
+		if (!start_64) handleError("\nUnable To Allocate Memory For Web Matrix.\n");
+
+		for (page = 0; page <= dimension; page++) start_64[page] = in_start[page];
+
+		matrix->start = matrix->buffers[0] = start_64;
+	}
+
+	if (!in_weight) matrix->value_type = VALUE_PATTERN;
+	else {
+		for (edge = 0; edge < num_edges && exact; edge++) exact = (double)(float)in_weight[edge] == in_weight[edge];
+
+		if (!exact) {
+			matrix->value_type = VALUE_DOUBLE;
+			matrix->weight = in_weight;
+		}
+		else {
+			weight_float = (float*)malloc((num_edges + 1) * sizeof(float));
+			if (!weight_float) handleError("\nUnable To Allocate Memory For Web Matrix.\n");
+
+			for (edge = 0; edge < num_edges; edge++) weight_float[edge] = (float)in_weight[edge];
+
+			matrix->value_type = VALUE_FLOAT;
+			matrix->weight = matrix->buffers[1] = weight_float;
+		}
+	}
+
+	return matrix;
+}
+
+/*
+ * Builds the Incoming Links of a Web Graph in the Narrowest Offset and Value Types.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: dynamically allocated WebMatrix, valid until graph is freed.
+ */
+WebMatrix* loadWebMatrix(WebGraph* graph) {
+	return buildWebMatrix(graph->dimension, graph->num_edges, graph->in_start, graph->in_source, graph->in_weight);
+}
+
+/*
+ * Deallocates a Web Matrix.
+ * PARAM: matrix is a pointer to a WebMatrix returned by loadWebMatrix.
+ * PRE: NONE
+ * POST: memory converted for matrix released; arrays of the WebGraph are untouched.
+ * RETURN: VOID
+ */
+void freeWebMatrix(WebMatrix* matrix) {
+	if (!matrix) return;
+
+	free(matrix->buffers[0]);
+	free(matrix->buffers[1]);
+	free(matrix);
+}
+
+/*
+ * Acquire the Narrowest Specialized Batch Width Holding a Number of Ranks.
+ *  Note: Batches of One or Two Ranks Are Not Padded. Wider Batches Are Padded to
+ *        a Multiple of KERNEL_SIMD_WIDTH, so 9 Topics Take 12 Lanes Rather Than 16.
+ * PARAM: num_ranks is the number of ranks per page.
+ * PRE: num_ranks is at most KERNEL_MAX_WIDTH.
+ * POST: NONE
+ * RETURN: smallest specialized width at least num_ranks.
+ */
+size_t getKernelWidth(size_t num_ranks) {
+	if (num_ranks <= 2) return num_ranks ? num_ranks : 1;
+	if (num_ranks >= KERNEL_MAX_WIDTH) return KERNEL_MAX_WIDTH;
+
+	return (num_ranks + KERNEL_SIMD_WIDTH - 1) / KERNEL_SIMD_WIDTH * KERNEL_SIMD_WIDTH;
+}
+
+/*
+ * Acquire the Kernels Specialized For a Web Matrix and Batch Width.
+ * PARAM: matrix is a pointer to a WebMatrix returned by buildWebMatrix.
+ * PARAM: num_ranks is the number of ranks per page updated together.
+ * PRE: num_ranks is at most KERNEL_MAX_WIDTH.
+ * POST: NONE
+ * RETURN: WebKernels whose batch width is getKernelWidth(num_ranks).
+ */
+WebKernels getKernels(WebMatrix* matrix, size_t num_ranks) {
+	/* Local Variables */
+	WebKernels kernels;
+	size_t width_index = 0;
+
+	/* Widths 1, 2, 4, 8, 12 and 16 Are Specialized. */
+	kernels.width = getKernelWidth(num_ranks);
+	width_index = kernels.width <= 2 ? kernels.width - 1 : kernels.width / KERNEL_SIMD_WIDTH + 1;
+
+	kernels.spmv = spmv_kernels[matrix->offset_type][matrix->value_type][width_index];
+	kernels.sweep = sweep_kernels[matrix->offset_type][matrix->value_type];
+
+	return kernels;
+}
+
+/*
+ * Select the Kernels Specialized For a Web Matrix and Batch Width.
+ * PARAM: matrix is a pointer to a WebMatrix returned by buildWebMatrix.
+ * PARAM: num_ranks is the number of ranks per page updated together.
+ * PRE: num_ranks is at most KERNEL_MAX_WIDTH.
+ * POST: selected specialization printed to stdout.
+ * RETURN: WebKernels whose batch width is getKernelWidth(num_ranks).
+ */
+WebKernels selectKernels(WebMatrix* matrix, size_t num_ranks) {
+	/* Local Variables */
+	WebKernels kernels = getKernels(matrix, num_ranks);
+
+	fprintf(stdout, "\nKernels : %i-Bit Offsets, %s Weights, %i Ranks Per Page\n",
+		matrix->offset_type == OFFSET_64 ? 64 : 32,
+		matrix->value_type == VALUE_PATTERN ? "No" : (matrix->value_type == VALUE_FLOAT ? "Float" : "Double"),
+		(int)kernels.width);
+
+	return kernels;
+}
+
+/*
+ * Select the Kernel Adding the Shares Along Blocks of Links Streamed From Disk.
+ * PARAM: weighted is TRUE IF link weights are streamed alongside the links.
+ * PRE: NONE
+ * POST: selected specialization printed to stdout.
+ * RETURN: StreamKernel for the streamed blocks.
+ */
+StreamKernel selectStreamKernel(int weighted) {
+	fprintf(stdout, "\nKernels : Streamed Blocks, %s Weights\n", weighted ? "Double" : "No");
+
+	return stream_kernels[weighted ? TRUE : FALSE];
+}
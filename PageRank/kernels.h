@@ -0,0 +1,109 @@
+/*
+ * File: kernels.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "websolver.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+/* Webs With More Links Than This Need 64-Bit Offsets. Sources Are Pages, so Always Fit 32 Bits. */
+#define KERNEL_OFFSET_LIMIT UINT32_MAX
+
+/* Pages Handed to One Kernel Call. */
+#define KERNEL_PAGES 1024
+
+/* Widest Batch of Ranks Updated Together. MAX_TOPICS is Defined as This Width. */
+#define KERNEL_MAX_WIDTH 16
+
+/* Doubles in One 256-Bit Vector Register. Batches Wider Than 2 Are Padded to a Multiple of This. */
+#define KERNEL_SIMD_WIDTH 4
+
+/* Kernels Are Inlined Into Each Specialization so Constant Widths Unroll. */
+#ifdef _MSC_VER
+#define KERNEL_INLINE static __forceinline
+#else
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+#endif
+
+/***********************/
+/**** Enumerations ****/
+/***********************/
+
+enum KERNEL_OFFSET {
+    OFFSET_32 = 0,
+    OFFSET_64 = 1
+};
+
+/* Pattern Matrices Have No Weights, so Every Link Has Weight One. */
+enum KERNEL_VALUE {
+    VALUE_PATTERN = 0,
+    VALUE_FLOAT = 1,
+    VALUE_DOUBLE = 2
+};
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Incoming Links of a WebGraph in the Narrowest Offset and Value Types That Hold Them.
+   Arrays in buffers Were Converted For the Matrix. The Others Alias the Caller's Arrays. */
+typedef struct {
+	size_t dimension;
+	int offset_type;
+	int value_type;
+
+	void *start;
+	unsigned int *source;
+	void *weight;
+
+	void *buffers[2];
+} WebMatrix;
+
+/* Adds the Incoming Shares of Pages first to last - 1 For Every Rank in a Batch.
+   A NULL teleport Returns the Whole Jump of Each Batch Entry to Every Page. */
+typedef void (*SpmvKernel)(const WebMatrix* matrix, const double* scaled, const double* jump, const double* teleport, double* rank, size_t first, size_t last);
+
+/* Gauss-Seidel Update of the Listed Pages. Returns the Sum of Squared Changes. */
+typedef double (*SweepKernel)(const WebMatrix* matrix, const double* share, double* pagerank, const unsigned int* pages, size_t count);
+
+/* Adds the Shares Along a Block of Links Streamed From Disk, Whose First Link is Link first and
+   Goes Into Page page. weights is NULL For Unweighted Webs. */
+typedef void (*StreamKernel)(const unsigned int* sources, const double* weights, const size_t* in_start, size_t page, size_t first, size_t count,
+	const double* share, double* pagerank);
+
+/* Kernels Specialized For One WebMatrix and Batch Width. */
+typedef struct {
+	size_t width;
+	SpmvKernel spmv;
+	SweepKernel sweep;
+} WebKernels;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+WebMatrix* buildWebMatrix(size_t dimension, size_t num_edges, size_t* in_start, unsigned int* in_source, double* in_weight);
+WebMatrix* loadWebMatrix(WebGraph* graph);
+void freeWebMatrix(WebMatrix* matrix);
+
+size_t getKernelWidth(size_t num_ranks);
+WebKernels getKernels(WebMatrix* matrix, size_t num_ranks);
+WebKernels selectKernels(WebMatrix* matrix, size_t num_ranks);
+StreamKernel selectStreamKernel(int weighted);
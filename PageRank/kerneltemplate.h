@@ -0,0 +1,171 @@
+/*
+ * File: kerneltemplate.h
+ * Purpose: Defines the Kernels of One Offset and Value Type. kernels.c Includes
+ * 			This File Once Per Specialization, Defining Beforehand :
+ * 			KERNEL_OFFSET_TYPE, the Type of Offsets Into the Links.
+ * 			KERNEL_VALUE_TYPE, the Type of Weights, Undefined For Pattern Matrices.
+ * 			KERNEL_SUFFIX, Appended to the Name of Each Kernel.
+ * 			KERNEL_STREAM, Defined to Also Define the Kernel of Streamed Blocks.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+/* No #pragma once, as Each Inclusion Defines Another Specialization. */
+
+/*
+ * Add the Incoming Shares of a Range of Pages For a Batch of Ranks.
+ *  Note: width is a Constant in Each Specialization Below, so the Loops Over the
+ *        Batch Unroll and the Sums Stay in Registers. No Branch Depends on the Link.
+ * PARAM: matrix is a pointer to a WebMatrix returned by buildWebMatrix.
+ * PARAM: scaled is the damped rank each page passes per unit weight, interleaved by page.
+ * PARAM: jump is the rank of each batch entry returned by random jumps and dangling pages.
+ * PARAM: teleport is the jump distribution of each batch entry, interleaved by page, or NULL
+ * 		  to return the whole jump to every page.
+ * PARAM: rank is the rank vector receiving the result, interleaved by page.
+ * PARAM: first is the first page to update.
+ * PARAM: last is one past the last page to update.
+ * PARAM: width is the number of ranks per page.
+ * PRE: NONE
+ * POST: rank of pages first to last - 1 is updated.
+ * RETURN: VOID
+ */
+KERNEL_INLINE void KERNEL_NAME(spmvBatch)(const WebMatrix* matrix, const double* scaled, const double* jump, const double* teleport, double* rank, size_t first, size_t last, const size_t width) {
+	/* Local Variables */
+	const KERNEL_OFFSET_TYPE *start = (const KERNEL_OFFSET_TYPE*)matrix->start;
+	const unsigned int *source = matrix->source;
+#ifdef KERNEL_VALUE_TYPE
+	const KERNEL_VALUE_TYPE *weight = (const KERNEL_VALUE_TYPE*)matrix->weight;
+	double link = 0;
+#endif
+	const double *column = NULL;
+	double sum[KERNEL_MAX_WIDTH];
+
+	size_t page = 0;
+	size_t edge = 0;
+	size_t lane = 0;
+
+	for (page = first; page < last; page++) {
+		if (teleport) for (lane = 0; lane < width; lane++) sum[lane] = jump[lane] * teleport[page * width + lane];
+		else for (lane = 0; lane < width; lane++) sum[lane] = jump[lane];
+
+		for (edge = start[page]; edge < start[page + 1]; edge++) {
+			column = scaled + (size_t)source[edge] * width;
+#ifdef KERNEL_VALUE_TYPE
+			link = (double)weight[edge];
+			for (lane = 0; lane < width; lane++) sum[lane] += link * column[lane];
+#else
+			for (lane = 0; lane < width; lane++) sum[lane] += column[lane];
+#endif
+		}
+
+		for (lane = 0; lane < width; lane++) rank[page * width + lane] = sum[lane];
+	}
+}
+
+/* Specializations For Each Batch Width. */
+#define KERNEL_SPMV(width) \
+	static void KERNEL_NAME(spmv##width)(const WebMatrix* matrix, const double* scaled, const double* jump, const double* teleport, double* rank, size_t first, size_t last) { \
+		KERNEL_NAME(spmvBatch)(matrix, scaled, jump, teleport, rank, first, last, width); \
+	}
+
+KERNEL_SPMV(1)
+KERNEL_SPMV(2)
+KERNEL_SPMV(4)
+KERNEL_SPMV(8)
+KERNEL_SPMV(12)
+KERNEL_SPMV(16)
+
+/*
+ * Update the PageRank of the Listed Pages in Place With Gauss-Seidel.
+ *  Note: Solves the System of the Initial Approximation, (I - p * M * D) * x = e.
+ * PARAM: matrix is a pointer to a WebMatrix returned by buildWebMatrix.
+ * PARAM: share is the damped fraction of its rank each page passes along one link, before link weights.
+ * PARAM: pagerank is the rank vector being solved.
+ * PARAM: pages is the array of pages to update, in order.
+ * PARAM: count is the number of pages to update.
+ * PRE: NONE
+ * POST: pagerank of the listed pages is updated.
+ * RETURN: sum of squared changes to the listed pages.
+ */
+static double KERNEL_NAME(sweep)(const WebMatrix* matrix, const double* share, double* pagerank, const unsigned int* pages, size_t count) {
+	/* Local Variables */
+	const KERNEL_OFFSET_TYPE *start = (const KERNEL_OFFSET_TYPE*)matrix->start;
+	const unsigned int *source = matrix->source;
+#ifdef KERNEL_VALUE_TYPE
+	const KERNEL_VALUE_TYPE *weight = (const KERNEL_VALUE_TYPE*)matrix->weight;
+#endif
+
+	size_t member = 0;
+	size_t edge = 0;
+	unsigned int page = 0;
+
+	double rank = 0;
+	double change = 0;
+
+	for (member = 0; member < count; member++) {
+		page = pages[member];
+
+		rank = 1;
+		for (edge = start[page]; edge < start[page + 1]; edge++) {
+#ifdef KERNEL_VALUE_TYPE
+			rank += share[source[edge]] * (double)weight[edge] * pagerank[source[edge]];
+#else
+			rank += share[source[edge]] * pagerank[source[edge]];
+#endif
+		}
+
+		change += (rank - pagerank[page]) * (rank - pagerank[page]);
+		pagerank[page] = rank;
+	}
+
+	return change;
+}
+
+#ifdef KERNEL_STREAM
+/*
+ * Add the Shares Along a Block of Links Streamed From Disk.
+ *  Note: Links Are in Destination Order, so the Links of Each Page in the Block
+ *        Are Summed Together and Added to its Rank Once.
+ * PARAM: sources is the source page of each link in the block.
+ * PARAM: weights is the weight of each link in the block, unused For Pattern Matrices.
+ * PARAM: in_start is the index of the first link into each page.
+ * PARAM: page is the destination of the block's first link.
+ * PARAM: first is the index of the block's first link.
+ * PARAM: count is the number of links in the block.
+ * PARAM: share is the rank each page passes along each of its outgoing links, per unit weight.
+ * PARAM: pagerank is the rank vector receiving the contributions.
+ * PRE: in_start[page] <= first < in_start[page + 1].
+ * POST: contributions of the block's links are added to pagerank.
+ * RETURN: VOID
+ */
+static void KERNEL_NAME(stream)(const unsigned int* sources, const double* weights, const size_t* in_start, size_t page, size_t first, size_t count,
+	const double* share, double* pagerank) {
+	/* Local Variables */
+	size_t edge = 0;
+	size_t last = 0;
+	double sum = 0;
+
+#ifndef KERNEL_VALUE_TYPE
+	(void)weights;
+#endif
+
+	/* Links Are Indexed Within the Block. */
+	for (; edge < count; page++) {
+		last = in_start[page + 1] - first < count ? in_start[page + 1] - first : count;
+
+		sum = 0;
+#ifdef KERNEL_VALUE_TYPE
+		for (; edge < last; edge++) sum += share[sources[edge]] * (double)weights[edge];
+#else
+		for (; edge < last; edge++) sum += share[sources[edge]];
+#endif
+		pagerank[page] += sum;
+	}
+}
+#endif
+
+#undef KERNEL_SPMV
+#undef KERNEL_STREAM
+#undef KERNEL_OFFSET_TYPE
+#undef KERNEL_VALUE_TYPE
+#undef KERNEL_SUFFIX
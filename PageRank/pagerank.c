@@ -8,27 +8,38 @@
 
 #include "pagerank.h"
 
+/* Global Variables */
+char input_buff[BUFFSIZE];
+char output_buff[BUFFSIZE];
+
 /* Static Variables */
-static char input_buff[BUFFSIZE];
 static char input_extra[BUFFSIZE];
-static char output_buff[BUFFSIZE];
 
 /*
  * Main Function Drives the Program.
- * PARAM: NONE
+ * PARAM: argc is the number of command line arguments.
+ * PARAM: argv is an array of command line arguments; the program runs as a
+ * 		  distributed worker when invoked as : pagerank worker <host> <port>
  * PRE: NONE
  * POST: matrix calculations performed in MATLAB engine.
  * RETURN: TRUE IF the program runs as intended
  *          OTHERWISE FALSE
 */
-int main(void) {
+int main(int argc, char *argv[]) {
+	program_path = argv[0];
+
+	/* Workers Calculate Their Range of the PageRank Without a MATLAB Engine. */
+	if (argc == 4 && !strcmp(argv[1], WORKER_MODE)) return runWorker(argv[2], argv[3]);
+
 	/* Start a MATLAB Process and Assign to a MATLAB Engine Object Pointer. */
 	Engine *ep = engOpen(NULL);
 
 	if (ep) runEngine(ep);
 	else handleError("\nCan't Start MATLAB Engine.\n");
 
+#ifdef _WIN32
 	system("pause");
+#endif
 	return TRUE;
 }
 
@@ -67,6 +78,13 @@ void runEngine(Engine *ep) {
 
 	dimension = getDimension(web_file);
 
+	/* Webs Too Large to Hold in Memory Are Streamed From Disk Instead. */
+	if (!fitsInCore(dimension)) {
+		fclose(web_file);
+		runOutOfCore(ep);
+		return;
+	}
+
 	/* Allocates Memory for Correctly-Sized Matrix. */
 	connectivity_matrix = (double**)calloc(dimension, sizeof(double*));
 	for (row = 0; row < dimension; row++) connectivity_matrix[row] = (double*)calloc(dimension, sizeof(double));
@@ -142,6 +160,37 @@ void runEngine(Engine *ep) {
 	if (engClose(ep)) fprintf(stderr, "\nFailed to Close MATLAB Engine.\n");
 }
 
+/*
+ * Run the MATLAB Engine With the Web Streamed From Disk.
+ *  Note: The Connectivity Matrix is Never Loaded. Only the PageRank
+ *        Vector is Written to the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened.
+ * POST: pagerank calculated out-of-core and printed to screen.
+ * RETURN: VOID
+*/
+void runOutOfCore(Engine *ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	mxArray *pagerank_result = NULL;
+
+	calculatePageRank(ep, OUT_OF_CORE);
+
+	pagerank_result = engGetVariable(ep, "x");
+
+	if (!pagerank_result) handleError("\nFailed to Retrieve PageRank Calculation.\n");
+	else printPageRank(ep, pagerank_result, mxGetNumberOfElements(pagerank_result));
+
+	mxDestroyArray(pagerank_result);
+	pagerank_result = NULL;
+
+	fprintf(stdout, "\n\nExiting Program...\n\n");
+
+	/* Clear MATLAB Engine. */
+	if (engClose(ep)) fprintf(stderr, "\nFailed to Close MATLAB Engine.\n");
+}
+
 /*
  * Print Variable Data in MATLAB Engine.
  * PARAM: ep is an Engine pointer to a MATLAB process.
@@ -197,6 +246,30 @@ int getCalculationMethod(Engine* ep) {
 		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
 		strcat_s(output_buff, BUFFSIZE, " For Principal EigenVector...\n ");
 
+		input_buff[0] = '0' + QUADRATIC_EXTRAPOLATION;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Quadratic Extrapolation...\n ");
+
+		input_buff[0] = '0' + OUT_OF_CORE;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Out-of-Core Power Method...\n ");
+
+		input_buff[0] = '0' + SCC_DECOMPOSITION;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Strongly Connected Component Decomposition...\n ");
+
+		input_buff[0] = '0' + DISTRIBUTED;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Distributed Power Method...\n ");
+
+		input_buff[0] = '0' + ASYNCHRONOUS;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Asynchronous Iteration...\n ");
+
+		input_buff[0] = '0' + TOPIC_SENSITIVE;
+		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
+		strcat_s(output_buff, BUFFSIZE, " For Topic-Sensitive PageRank...\n ");
+
 		input_buff[0] = '0' + FALSE;
 		strncat_s(output_buff, BUFFSIZE, input_buff, sizeof(char));
 		strcat_s(output_buff, BUFFSIZE, " To Exit Program...\n\n Enter Configuration : ");
@@ -207,7 +280,7 @@ int getCalculationMethod(Engine* ep) {
 	} while
 		((sscanf_s(input_buff, "%d%s", &calculation_config, input_extra, BUFFSIZE) != TRUE)
 		|| (calculation_config < FALSE)
-		|| (calculation_config > PRINCIPAL_EIGENVECTOR));
+		|| (calculation_config > TOPIC_SENSITIVE));
 
 	return calculation_config;
 }
@@ -227,6 +300,12 @@ void calculatePageRank(Engine *ep, int calculation_method) {
 	if (calculation_method == INITIAL_APPROXIMATION) calculateApproximation(ep);
 	else if (calculation_method == POWER_METHOD) calculatePowerMethod(ep);
 	else if (calculation_method == PRINCIPAL_EIGENVECTOR) calculatePrincipalEigenVector(ep);
+	else if (calculation_method == QUADRATIC_EXTRAPOLATION) calculateQuadraticExtrapolation(ep);
+	else if (calculation_method == OUT_OF_CORE) calculateOutOfCore(ep);
+	else if (calculation_method == SCC_DECOMPOSITION) calculateSCCDecomposition(ep);
+	else if (calculation_method == DISTRIBUTED) calculateDistributed(ep);
+	else if (calculation_method == ASYNCHRONOUS) calculateAsynchronous(ep);
+	else if (calculation_method == TOPIC_SENSITIVE) calculateTopicSensitive(ep);
 	else handleError("\nInvalid PageRank Calculation.\n");
 
 	fprintf(stdout, "_______________________________\n");
@@ -295,6 +374,107 @@ void calculatePowerMethod(Engine *ep) {
 
 	fprintf(stdout, "\nPower Method Calculation...\n");
 
+	calculateTransitionMatrix(ep);
+
+	/* Iterate to Calculate PageRank With Power Method Until PageRank Stops Changing. */
+	if (engEvalString(ep, "xPrev = zeros(cols, 1); xCurr = ones(cols, 1); iterations = 0;"))
+		handleError("\nPAGERANK ERROR: Could Not Generate a Zeros and Ones Array.\n");
+	loadCheckpointVariable(ep, "xCurr", POWER_METHOD, "iterations", "xPrev");
+	if (engEvalString(ep, "tic;"))
+		handleError("\nPAGERANK ERROR: Could Not Start Power Method Timer.\n");
+	if (engEvalString(ep, "while norm(ldivide(dim, (xCurr - xPrev))) > 0.01  xPrev = xCurr; xCurr = A * xCurr; iterations = iterations + 1; end;"))
+		handleError("\nPAGERANK ERROR: Could Not Iteratively Calculate PageRank With Power Method.\n");
+	if (engEvalString(ep, "elapsed = toc;"))
+		handleError("\nPAGERANK ERROR: Could Not Stop Power Method Timer.\n");
+	saveCheckpointVariable(ep, "xCurr", POWER_METHOD, "iterations");
+
+	/* Normalize PageRank Vector Values. */
+	if (engEvalString(ep, "x = xCurr/ sum(xCurr);"))
+		handleError("\nPAGERANK ERROR: Could Not Normalize PageRank Vector Values.\n");
+
+	printTelemetry(ep, "Power Method", "iterations", "elapsed");
+}
+
+/*
+ * Calculate the PageRank With the Power Method Accelerated by Periodic
+ * Quadratic Extrapolation (Kamvar et al.) in the MATLAB Engine.
+ *  Note: Every Few Iterations, the Last Four Iterates Are Combined to Cancel the
+ *        Second and Third EigenVector Components Which Slow the Power Method.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for quadratic extrapolation.
+ * POST: appropriate calculation method is performed to yield pagerank
+ *       in MATLAB array x; iterations and wall time are printed alongside
+ *       those of the plain power method.
+ * RETURN: VOID
+*/
+void calculateQuadraticExtrapolation(Engine *ep) {
+	if (!ep) return;
+
+	fprintf(stdout, "\nQuadratic Extrapolation Calculation...\n");
+
+	calculateTransitionMatrix(ep);
+
+	/* Number of Power Method Iterations Between Extrapolations, Which Must Be at Least the Three Iterates Combined. */
+	if (engEvalString(ep, "extrapolationPeriod = 5;"))
+		handleError("\nPAGERANK ERROR: Could Not Initialize Extrapolation Period.\n");
+
+	/* Both Runs Stop Once an Iteration Changes the PageRank by Less Than This Fraction of its Sum,
+	   as the Legacy Stop Test Ends Before the First Extrapolation. */
+	if (engEvalString(ep, "extrapolationTolerance = 1e-8;"))
+		handleError("\nPAGERANK ERROR: Could Not Initialize Extrapolation Tolerance.\n");
+
+	/* Iterate With Power Method, Keeping the Three Previous Iterates For Extrapolation. */
+	if (engEvalString(ep, "xPrev = zeros(cols, 1); xCurr = ones(cols, 1); xHist = zeros(cols, 3); iterations = 0;"))
+		handleError("\nPAGERANK ERROR: Could Not Generate a Zeros and Ones Array.\n");
+	loadCheckpointVariable(ep, "xCurr", QUADRATIC_EXTRAPOLATION, "iterations", "xPrev");
+	if (engEvalString(ep, "xStart = xCurr;"))
+		handleError("\nPAGERANK ERROR: Could Not Copy Starting PageRank Vector.\n");
+	if (engEvalString(ep, "tic;"))
+		handleError("\nPAGERANK ERROR: Could Not Start Quadratic Extrapolation Timer.\n");
+	if (engEvalString(ep,
+		"while norm(xCurr - xPrev, 1) > extrapolationTolerance * sum(xCurr) "
+			"xHist = [xHist(:, 2:3), xCurr]; xPrev = xCurr; xCurr = A * xCurr; iterations = iterations + 1; "
+			"if mod(iterations, extrapolationPeriod) == 0 "
+				"Y = xHist(:, 2:3) - xHist(:, 1); "
+				"gamma = -(Y \\ (xCurr - xHist(:, 1))); "
+				"if all(isfinite(gamma)) "
+					"xCurr = (gamma(1) + gamma(2) + 1) * xHist(:, 2) + (gamma(2) + 1) * xHist(:, 3) + xCurr; "
+					"xCurr = xCurr * (dim / sum(xCurr)); "
+				"end; "
+			"end; "
+		"end;"))
+		handleError("\nPAGERANK ERROR: Could Not Iteratively Calculate PageRank With Quadratic Extrapolation.\n");
+	if (engEvalString(ep, "elapsed = toc;"))
+		handleError("\nPAGERANK ERROR: Could Not Stop Quadratic Extrapolation Timer.\n");
+	saveCheckpointVariable(ep, "xCurr", QUADRATIC_EXTRAPOLATION, "iterations");
+
+	/* Repeat the Plain Power Method From the Same Start on the Same Transition Matrix as a Baseline. */
+	if (engEvalString(ep, "xBasePrev = zeros(cols, 1); xBase = xStart; baseIterations = 0; tic;"))
+		handleError("\nPAGERANK ERROR: Could Not Start Power Method Timer.\n");
+	if (engEvalString(ep, "while norm(xBase - xBasePrev, 1) > extrapolationTolerance * sum(xBase)  xBasePrev = xBase; xBase = A * xBase; baseIterations = baseIterations + 1; end;"))
+		handleError("\nPAGERANK ERROR: Could Not Iteratively Calculate PageRank With Power Method.\n");
+	if (engEvalString(ep, "baseElapsed = toc;"))
+		handleError("\nPAGERANK ERROR: Could Not Stop Power Method Timer.\n");
+
+	/* Normalize PageRank Vector Values. */
+	if (engEvalString(ep, "x = xCurr/ sum(xCurr);"))
+		handleError("\nPAGERANK ERROR: Could Not Normalize PageRank Vector Values.\n");
+
+	printTelemetry(ep, "Quadratic Extrapolation", "iterations", "elapsed");
+	printTelemetry(ep, "Power Method", "baseIterations", "baseElapsed");
+}
+
+/*
+ * Calculate the Transition Matrix of the Connectivity Matrix in the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; connectivity matrix stored in MATLAB array M.
+ * POST: transition matrix stored in MATLAB array A; dimension stored in dim.
+ * RETURN: VOID
+*/
+void calculateTransitionMatrix(Engine *ep) {
+	if (!ep) return;
+
 	/* Calculate Size of Connectivity Matrix. */
 	if (engEvalString(ep, "[rows, cols] = size(M);"))
 		handleError("\nPAGERANK ERROR: Could Not Assign Row and Column Sizes of Connectivity Matrix to Variables.\n");
@@ -331,16 +511,6 @@ void calculatePowerMethod(Engine *ep) {
 		handleError("\nPAGERANK ERROR: Could Not Generate a Ones Array.\n");
 	if (engEvalString(ep, "A = p * S + e * z;"))
 		handleError("\nPAGERANK ERROR: Could Not Calculate Transition Matrix.\n");
-
-	/* Iterate to Calculate PageRank With Power Method Until PageRank Stops Changing. */
-	if (engEvalString(ep, "xPrev = zeros(cols, 1); xCurr = ones(cols, 1);"))
-		handleError("\nPAGERANK ERROR: Could Not Generate a Zeros and Ones Array.\n");
-	if (engEvalString(ep, "while norm(ldivide(dim, (xCurr - xPrev))) > 0.01  xPrev = xCurr; xCurr = A * xCurr; end;"))
-		handleError("\nPAGERANK ERROR: Could Not Iteratively Calculate PageRank With Power Method.\n");
-
-	/* Normalize PageRank Vector Values. */
-	if (engEvalString(ep, "x = xCurr/ sum(xCurr);"))
-		handleError("\nPAGERANK ERROR: Could Not Normalize PageRank Vector Values.\n");
 }
 
 /*
@@ -395,16 +565,78 @@ void printPageRank(Engine *ep, mxArray *pagerank, size_t size_pagerank) {
 
 	/* Local Variables */
 	size_t page_index = 0;
+	size_t column = 0;
 	mxDouble* data_pagerank = mxGetPr(pagerank);
 
+	/* Topic-Sensitive PageRank Has One Column Per Topic. */
+	size_t num_columns = mxGetN(pagerank) ? mxGetN(pagerank) : 1;
+	size_t num_pages = size_pagerank / num_columns;
+
 	fprintf(stdout, "\nPageRank Retrieved :\n\n");
-	for (page_index = 0; page_index < size_pagerank; page_index++) {
+	for (page_index = 0; page_index < num_pages; page_index++) {
 		fprintf(stdout, "PAGE : %i ", (int)(page_index + 1));
-		fprintf(stdout, "RANK : %.4f\n", data_pagerank[page_index]);
+		fprintf(stdout, "RANK :");
+		for (column = 0; column < num_columns; column++) fprintf(stdout, " %.4f", data_pagerank[column * num_pages + page_index]);
+		fprintf(stdout, "\n");
 	}
 	fprintf(stdout, "\n");
 }
 
+/*
+ * Normalize a PageRank Calculated in C and Store it in the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PARAM: pagerank is an array of unnormalized page ranks.
+ * PARAM: size_pagerank is the number of pages.
+ * PRE: MATLAB engine successfully opened.
+ * POST: normalized pagerank stored in MATLAB array x.
+ * RETURN: VOID
+ */
+void storePageRank(Engine *ep, double *pagerank, size_t size_pagerank) {
+	if (!ep) return;
+
+	/* Local Variables */
+	size_t page_index = 0;
+	double total = 0;
+
+	mxArray *pagerank_array = mxCreateDoubleMatrix(size_pagerank, 1, mxREAL);
+	mxDouble *data_pagerank = NULL;
+
+	if (!pagerank_array) handleError("\nUnable To Allocate PageRank Array.\n");
+	else data_pagerank = mxGetPr(pagerank_array);
+
+	for (page_index = 0; page_index < size_pagerank; page_index++) total += pagerank[page_index];
+	for (page_index = 0; page_index < size_pagerank; page_index++) data_pagerank[page_index] = pagerank[page_index] / total;
+
+	if (engPutVariable(ep, "x", pagerank_array)) handleError("\nCannot Write Array to MATLAB.\n");
+
+	mxDestroyArray(pagerank_array);
+}
+
+/*
+ * Print Iteration Count and Wall Time of a PageRank Calculation To Standard Output.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PARAM: label is a char array naming the calculation method.
+ * PARAM: iterations_variable is the MATLAB variable holding the iteration count.
+ * PARAM: elapsed_variable is the MATLAB variable holding the wall time in seconds.
+ * PRE: MATLAB engine successfully opened; pagerank calculation timed in MATLAB engine.
+ * POST: telemetry printed to stdout.
+ * RETURN: VOID
+ */
+void printTelemetry(Engine *ep, char *label, char *iterations_variable, char *elapsed_variable) {
+	if (!ep) return;
+
+	/* Local Variables */
+	mxArray *iterations = engGetVariable(ep, iterations_variable);
+	mxArray *elapsed = engGetVariable(ep, elapsed_variable);
+
+	if (!iterations || !elapsed) handleError("\nFailed to Retrieve PageRank Telemetry.\n");
+
+	fprintf(stdout, "\n%s : %i Iterations In %.6f Seconds\n", label, (int)mxGetScalar(iterations), mxGetScalar(elapsed));
+
+	mxDestroyArray(iterations);
+	mxDestroyArray(elapsed);
+}
+
 /*
  * Print Error Message to Standard Output and Exit Program.
  * PARAM: message is a char array to print to screen.
@@ -414,7 +646,9 @@ void printPageRank(Engine *ep, mxArray *pagerank, size_t size_pagerank) {
  */
 void handleError(char* message) {
 	fprintf(stderr, message);
+#ifdef _WIN32
 	system("pause");
+#endif
 
 	exit(TRUE);
 }
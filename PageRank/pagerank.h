@@ -16,8 +16,17 @@
 #include <string.h>
 #include <math.h>
 
+#include "portable.h"
 #include "engine.h"
 #include "websolver.h"
+#include "kernels.h"
+#include "blockio.h"
+#include "blockstream.h"
+#include "sccsolver.h"
+#include "distributed.h"
+#include "asyncsolver.h"
+#include "checkpoint.h"
+#include "topicsolver.h"
 
 /***************************/
 /* Preprocessor Directives */
@@ -32,7 +41,13 @@
 enum PAGERANK_METHODS {
     INITIAL_APPROXIMATION = 1,
     POWER_METHOD = 2,
-    PRINCIPAL_EIGENVECTOR = 3
+    PRINCIPAL_EIGENVECTOR = 3,
+    QUADRATIC_EXTRAPOLATION = 4,
+    OUT_OF_CORE = 5,
+    SCC_DECOMPOSITION = 6,
+    DISTRIBUTED = 7,
+    ASYNCHRONOUS = 8,
+    TOPIC_SENSITIVE = 9
 };
 
 /***************************/
@@ -47,6 +62,7 @@ extern char output_buff[];
 /***********************/
 
 void runEngine(Engine *ep);
+void runOutOfCore(Engine *ep);
 void retrieveVariables(Engine* ep);
 
 int getCalculationMethod(Engine* ep);
@@ -56,7 +72,12 @@ void calculatePageRank(Engine *ep, int calculation_method);
 void calculatePrincipalEigenVector(Engine *ep);
 void calculateApproximation(Engine *ep);
 void calculatePowerMethod(Engine *ep);
+void calculateQuadraticExtrapolation(Engine *ep);
+void calculateTransitionMatrix(Engine *ep);
+
+void printTelemetry(Engine *ep, char *label, char *iterations_variable, char *elapsed_variable);
 
 void printPageRank(Engine *ep, mxArray *pagerank, size_t size_pagerank);
+void storePageRank(Engine *ep, double *pagerank, size_t size_pagerank);
 
 void handleError(char* message);
@@ -0,0 +1,100 @@
+/*
+ * File: portable.h
+ * Purpose: Maps the Bounds-Checked Functions of the Microsoft C Runtime
+ * 			to Standard C When Building With Other Compilers.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+#ifndef _MSC_VER
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+#define fopen_s(file, name, mode) ((*(file) = fopen((name), (mode))) == NULL)
+
+/************************/
+/* Function Definitions */
+/************************/
+
+/*
+ * Copy a String Into a Buffer of Known Size.
+ * PARAM: destination is the buffer to copy into.
+ * PARAM: size is the size of destination.
+ * PARAM: source is the string to copy.
+ * PRE: NONE
+ * POST: destination holds as much of source as fits.
+ * RETURN: 0 on success, like its Microsoft counterpart.
+ */
+static inline int strcpy_s(char* destination, size_t size, const char* source) {
+	return snprintf(destination, size, "%s", source) < 0;
+}
+
+/*
+ * Append a String to a Buffer of Known Size.
+ * PARAM: destination is the buffer to append to.
+ * PARAM: size is the size of destination.
+ * PARAM: source is the string to append.
+ * PRE: destination holds a string shorter than size.
+ * POST: destination ends with as much of source as fits.
+ * RETURN: 0 on success, like its Microsoft counterpart.
+ */
+static inline int strcat_s(char* destination, size_t size, const char* source) {
+	/* Local Variables */
+	size_t length = strlen(destination);
+
+	return snprintf(destination + length, size - length, "%s", source) < 0;
+}
+
+/*
+ * Append at Most count Characters of a String to a Buffer of Known Size.
+ * PARAM: destination is the buffer to append to.
+ * PARAM: size is the size of destination.
+ * PARAM: source is the string to append.
+ * PARAM: count is the most characters of source to append.
+ * PRE: destination holds a string shorter than size.
+ * POST: destination ends with as much of source as fits.
+ * RETURN: 0 on success, like its Microsoft counterpart.
+ */
+static inline int strncat_s(char* destination, size_t size, const char* source, size_t count) {
+	/* Local Variables */
+	size_t length = strlen(destination);
+
+	return snprintf(destination + length, size - length, "%.*s", (int)count, source) < 0;
+}
+
+/*
+ * Read Formatted Input From a String.
+ *  Note: Arguments Are Read in Order, so the Size Following a String Argument
+ *        is Only Skipped Safely When That String is the Last One Scanned. Such
+ *        a String Must Be as Large as buffer, as its Size is Not Checked.
+ * PARAM: buffer is the string to read from.
+ * PARAM: format is the scanf format string, with at most one string conversion, last.
+ * PRE: string arguments hold at least as many characters as buffer.
+ * POST: arguments receive the values read.
+ * RETURN: number of values read; EOF IF buffer ended first.
+ */
+static inline int sscanf_s(const char* buffer, const char* format, ...) {
+	/* Local Variables */
+	va_list arguments;
+	int count = 0;
+
+	va_start(arguments, format);
+	count = vsscanf(buffer, format, arguments);
+	va_end(arguments);
+
+	return count;
+}
+
+#endif
@@ -0,0 +1,301 @@
+/*
+ * File: sccsolver.c
+ * Purpose: Calculates PageRank by Decomposing the Web Into Strongly Connected
+ * 			Components and Solving Them in Topological Order.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* Include Header */
+#include "sccsolver.h"
+#include "pagerank.h"
+
+/*
+ * Decomposes the Non-Dangling Pages Into Strongly Connected Components.
+ *  Note: Tarjan's Algorithm is Run With an Explicit Stack so Long Link Chains
+ *        Cannot Overflow the Call Stack. Dangling Pages Link Nowhere, so They
+ *        Are Lumped Together and Left Out of the Decomposition.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: dynamically allocated WebComponents, released with freeWebComponents.
+ */
+WebComponents* decomposeWeb(WebGraph* graph) {
+	/* Local Variables */
+	WebComponents *components = NULL;
+	size_t dimension = graph->dimension;
+
+	unsigned int *index = NULL;
+	unsigned int *lowlink = NULL;
+	unsigned int *scc_stack = NULL;
+	unsigned int *call_stack = NULL;
+	unsigned int *level = NULL;
+	size_t *next_edge = NULL;
+	char *on_stack = NULL;
+
+	unsigned int counter = 0;
+	size_t scc_top = 0;
+	size_t call_top = 0;
+
+	unsigned int root = 0;
+	unsigned int page = 0;
+	unsigned int target = 0;
+	unsigned int parent = 0;
+	unsigned int member = 0;
+	unsigned int component = 0;
+	size_t edge = 0;
+	size_t link = 0;
+
+	components = (WebComponents*)calloc(1, sizeof(WebComponents));
+	if (!components) handleError("\nUnable To Allocate Memory For Web Components.\n");
+
+	components->component = (unsigned int*)malloc(dimension * sizeof(unsigned int));
+	index = (unsigned int*)malloc(dimension * sizeof(unsigned int));
+	lowlink = (unsigned int*)malloc(dimension * sizeof(unsigned int));
+	scc_stack = (unsigned int*)malloc(dimension * sizeof(unsigned int));
+	call_stack = (unsigned int*)malloc(dimension * sizeof(unsigned int));
+	next_edge = (size_t*)malloc(dimension * sizeof(size_t));
+	on_stack = (char*)calloc(dimension, sizeof(char));
+
+	if (!components->component || !index || !lowlink || !scc_stack || !call_stack || !next_edge || !on_stack)
+		handleError("\nUnable To Allocate Memory For Web Components.\n");
+
+	for (page = 0; page < dimension; page++) {
+		index[page] = UNVISITED;
+		components->component[page] = UNVISITED;
+		if (!graph->out_degree[page]) components->num_dangling++;
+	}
+
+	for (root = 0; root < dimension; root++) {
+		if (index[root] != UNVISITED || !graph->out_degree[root]) continue;
+
+		index[root] = lowlink[root] = counter++;
+		next_edge[root] = graph->out_start[root];
+		scc_stack[scc_top++] = root;
+		on_stack[root] = TRUE;
+		call_stack[call_top++] = root;
+
+		while (call_top) {
+			page = call_stack[call_top - 1];
+
+			/* Visit the Next Outgoing Link of the Page on Top of the Call Stack. */
+			if (next_edge[page] < graph->out_start[page + 1]) {
+				target = graph->out_target[next_edge[page]++];
+				if (!graph->out_degree[target]) continue;
+
+				if (index[target] == UNVISITED) {
+					index[target] = lowlink[target] = counter++;
+					next_edge[target] = graph->out_start[target];
+					scc_stack[scc_top++] = target;
+					on_stack[target] = TRUE;
+					call_stack[call_top++] = target;
+				}
+				else if (on_stack[target] && index[target] < lowlink[page]) lowlink[page] = index[target];
+				continue;
+			}
+
+			/* All Links Visited, Return to the Parent Page. */
+			call_top--;
+			if (call_top) {
+				parent = call_stack[call_top - 1];
+				if (lowlink[page] < lowlink[parent]) lowlink[parent] = lowlink[page];
+			}
+
+			/* Page is the Root of a Component, Pop its Members. */
+			if (lowlink[page] == index[page]) {
+				do {
+					member = scc_stack[--scc_top];
+					on_stack[member] = FALSE;
+					components->component[member] = components->num_components;
+				} while (member != page);
+				components->num_components++;
+			}
+		}
+	}
+
+	/* Group Pages by Component. */
+	components->member_start = (size_t*)calloc(components->num_components + 1, sizeof(size_t));
+	components->members = (unsigned int*)malloc((dimension - components->num_dangling + 1) * sizeof(unsigned int));
+	level = (unsigned int*)calloc(components->num_components + 1, sizeof(unsigned int));
+	if (!components->member_start || !components->members || !level) handleError("\nUnable To Allocate Memory For Web Components.\n");
+
+	for (page = 0; page < dimension; page++) {
+		if (components->component[page] != UNVISITED) components->member_start[components->component[page] + 1]++;
+	}
+	for (component = 0; component < components->num_components; component++) {
+		components->member_start[component + 1] += components->member_start[component];
+		next_edge[component] = components->member_start[component];
+	}
+	for (page = 0; page < dimension; page++) {
+		if (components->component[page] != UNVISITED) components->members[next_edge[components->component[page]]++] = page;
+	}
+
+	/* Tarjan's Algorithm Numbers Components in Reverse Topological Order, so
+	   Levels Are Propagated From the Last Component to the First. */
+	for (component = components->num_components; component-- > 0;) {
+		if (level[component] + 1 > components->num_levels) components->num_levels = level[component] + 1;
+
+		for (edge = components->member_start[component]; edge < components->member_start[component + 1]; edge++) {
+			page = components->members[edge];
+			for (link = graph->out_start[page]; link < graph->out_start[page + 1]; link++) {
+				target = components->component[graph->out_target[link]];
+				if (target != UNVISITED && target != component && level[target] < level[component] + 1) level[target] = level[component] + 1;
+			}
+		}
+	}
+
+	/* Group Components by Level, Reusing index as the Fill Position of Each Level. */
+	components->level_start = (unsigned int*)calloc(components->num_levels + 1, sizeof(unsigned int));
+	components->level_components = (unsigned int*)malloc((components->num_components + 1) * sizeof(unsigned int));
+	if (!components->level_start || !components->level_components) handleError("\nUnable To Allocate Memory For Web Components.\n");
+
+	for (component = 0; component < components->num_components; component++) components->level_start[level[component] + 1]++;
+	for (root = 0; root < components->num_levels; root++) {
+		components->level_start[root + 1] += components->level_start[root];
+		index[root] = components->level_start[root];
+	}
+	for (component = 0; component < components->num_components; component++) components->level_components[index[level[component]]++] = component;
+
+	free(index);
+	free(lowlink);
+	free(scc_stack);
+	free(call_stack);
+	free(next_edge);
+	free(on_stack);
+	free(level);
+
+	return components;
+}
+
+/*
+ * Deallocates Web Components.
+ * PARAM: components is a pointer to WebComponents returned by decomposeWeb.
+ * PRE: NONE
+ * POST: memory for components released.
+ * RETURN: VOID
+ */
+void freeWebComponents(WebComponents* components) {
+	if (!components) return;
+
+	free(components->component);
+	free(components->member_start);
+	free(components->members);
+	free(components->level_start);
+	free(components->level_components);
+	free(components);
+}
+
+/*
+ * Solve the PageRank of the Pages in One Component.
+ *  Note: Gauss-Seidel Sweeps Are Applied Only to the Pages of the Component.
+ *        Links From Earlier Components Are Already Solved and Held Fixed.
+ * PARAM: matrix is a pointer to a WebMatrix returned by loadWebMatrix.
+ * PARAM: sweep is the SweepKernel selected for matrix.
+ * PARAM: components is a pointer to WebComponents returned by decomposeWeb.
+ * PARAM: component is the index of the component to solve.
+ * PARAM: share is the damped fraction of its rank each page passes along one link, before link weights.
+ * PARAM: pagerank is the rank vector being solved.
+ * PRE: every component linking to this component is solved.
+ * POST: pagerank of the component's pages is solved.
+ * RETURN: number of sweeps performed.
+ */
+int solveComponent(WebMatrix* matrix, SweepKernel sweep, WebComponents* components, unsigned int component, double* share, double* pagerank) {
+	/* Local Variables */
+	size_t first = components->member_start[component];
+	size_t last = components->member_start[component + 1];
+
+	double change = 0;
+	int sweeps = 0;
+
+	do {
+		change = sweep(matrix, share, pagerank, components->members + first, last - first);
+		sweeps++;
+	} while (sqrt(change) / (last - first) > COMPONENT_TOLERANCE);
+
+	return sweeps;
+}
+
+/*
+ * Calculate the PageRank by Strongly Connected Component Decomposition.
+ *  Note: Solves the System of the Initial Approximation, (I - p * M * D) * x = e,
+ *        One Component at a Time. Components on the Same Topological Level Do Not
+ *        Link to Each Other and Are Solved in Parallel. The Lumped Dangling Pages
+ *        Are Solved Last in a Single Pass.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for strongly connected component decomposition.
+ * POST: pagerank stored in MATLAB array x.
+ * RETURN: VOID
+ */
+void calculateSCCDecomposition(Engine* ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	WebGraph *graph = NULL;
+	WebComponents *components = NULL;
+	WebMatrix *matrix = NULL;
+	WebKernels kernels;
+
+	double *share = NULL;
+	double *pagerank = NULL;
+
+	size_t largest = 0;
+	unsigned int level = 0;
+	unsigned int component = 0;
+	int position = 0;
+	int page = 0;
+	int sweeps = 0;
+	clock_t start = 0;
+
+	fprintf(stdout, "\nStrongly Connected Component Decomposition...\n");
+
+	graph = loadWebGraph();
+	matrix = loadWebMatrix(graph);
+	kernels = selectKernels(matrix, 1);
+
+	start = clock();
+	components = decomposeWeb(graph);
+
+	share = (double*)malloc(graph->dimension * sizeof(double));
+	pagerank = (double*)malloc(graph->dimension * sizeof(double));
+	if (!share || !pagerank) handleError("\nUnable To Allocate Memory For PageRank.\n");
+
+	computeShares(graph, share);
+	for (page = 0; page < (int)graph->dimension; page++) pagerank[page] = 1;
+	/* A Converged Checkpoint of This Web Needs No Sweeps. */
+	if (loadCheckpoint(SCC_DECOMPOSITION, graph->key, pagerank, graph->dimension, graph->out_degree, &sweeps) != CHECKPOINT_COMPLETE) {
+		for (level = 0; level < components->num_levels; level++) {
+			#pragma omp parallel for schedule(dynamic) reduction(+:sweeps)
+			for (position = (int)components->level_start[level]; position < (int)components->level_start[level + 1]; position++) {
+				sweeps += solveComponent(matrix, kernels.sweep, components, components->level_components[position], share, pagerank);
+			}
+		}
+
+		/* Every Other Page is Solved, so the Dangling Pages Need Only One Pass. */
+		#pragma omp parallel for
+		for (page = 0; page < (int)graph->dimension; page++) {
+			unsigned int dangling = (unsigned int)page;
+
+			if (!graph->out_degree[page]) kernels.sweep(matrix, share, pagerank, &dangling, 1);
+		}
+	}
+
+	for (component = 0; component < components->num_components; component++) {
+		if (components->member_start[component + 1] - components->member_start[component] > largest) largest = components->member_start[component + 1] - components->member_start[component];
+	}
+
+	fprintf(stdout, "\nSCC Decomposition : %u Components (Largest %i Pages), %u Dangling Pages Lumped, %i Sweeps In %.6f Seconds\n",
+		components->num_components, (int)largest, components->num_dangling, sweeps, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	saveCheckpoint(SCC_DECOMPOSITION, graph->key, pagerank, graph->dimension, sweeps, TRUE);
+	storePageRank(ep, pagerank, graph->dimension);
+
+	/* Deallocate Memory. */
+	freeWebComponents(components);
+	freeWebMatrix(matrix);
+	freeWebGraph(graph);
+	free(share);
+	free(pagerank);
+}
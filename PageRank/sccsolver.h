@@ -0,0 +1,61 @@
+/*
+ * File: sccsolver.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "engine.h"
+#include "websolver.h"
+#include "kernels.h"
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+/* Marks Pages Not Yet Visited by Tarjan's Algorithm. */
+#define UNVISITED 0xFFFFFFFF
+
+/* Components Feed Downstream Components, so They Are Solved Tighter Than RANK_TOLERANCE. */
+#define COMPONENT_TOLERANCE 1e-10
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Strongly Connected Components of the Non-Dangling Pages, Grouped by Topological Level.
+   Pages of Component c Are members[member_start[c]] to members[member_start[c + 1] - 1]. */
+typedef struct {
+	unsigned int num_components;
+	unsigned int num_levels;
+	unsigned int num_dangling;
+
+	unsigned int *component;
+	size_t *member_start;
+	unsigned int *members;
+
+	unsigned int *level_start;
+	unsigned int *level_components;
+} WebComponents;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+WebComponents* decomposeWeb(WebGraph* graph);
+void freeWebComponents(WebComponents* components);
+
+int solveComponent(WebMatrix* matrix, SweepKernel sweep, WebComponents* components, unsigned int component, double* share, double* pagerank);
+void calculateSCCDecomposition(Engine* ep);
@@ -0,0 +1,275 @@
+/*
+ * File: topicsolver.c
+ * Purpose: Calculates the Topic-Sensitive PageRank of Several Topics at Once,
+ * 			Reading Each Link Once Per Iteration For Every Topic.
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* Include Header */
+#include "topicsolver.h"
+#include "pagerank.h"
+
+/*
+ * Loads the Teleport Distributions of the Topics From the Topic File.
+ *  Note: Each Line of the Topic File is One Topic, Listing its Pages Numbered
+ *        From 1. A Page May Be Given a Weight as page:weight. Without a Topic
+ *        File, a Single Topic Teleports Uniformly, Which is the Plain PageRank.
+ * PARAM: dimension is a variable of type size_t representing the number of pages.
+ * PRE: NONE
+ * POST: NONE
+ * RETURN: dynamically allocated WebTopics with each topic normalized to sum to one.
+ */
+WebTopics* loadTopics(size_t dimension) {
+	/* Local Variables */
+	FILE *topic_file = NULL;
+	WebTopics *topics = NULL;
+
+	double *distribution = NULL;
+	double topic_sum[MAX_TOPICS];
+	double weight = 0;
+
+	unsigned long page = 0;
+	size_t num_topics = 0;
+	size_t topic = 0;
+	size_t index = 0;
+	int file_char = EOF;
+	int in_topic = FALSE;
+
+	topics = (WebTopics*)calloc(1, sizeof(WebTopics));
+	distribution = (double*)calloc(MAX_TOPICS * dimension, sizeof(double));
+	if (!topics || !distribution) handleError("\nUnable To Allocate Memory For Topics.\n");
+
+	if (!fopen_s(&topic_file, TOPIC_FILE, "r") && topic_file) {
+		while ((file_char = fgetc(topic_file)) != EOF) {
+			if (file_char == '\n') {
+				if (in_topic) num_topics++;
+				in_topic = FALSE;
+				continue;
+			}
+			if (file_char == ' ' || file_char == '\t' || file_char == '\r') continue;
+
+			ungetc(file_char, topic_file);
+			if (fscanf(topic_file, "%lu", &page) != TRUE) handleError("\nUnable To Parse Topic File:\n");
+
+			/* Pages Without a Weight Have Weight One. */
+			weight = 1;
+			if ((file_char = fgetc(topic_file)) == ':') {
+				if (fscanf(topic_file, "%lf", &weight) != TRUE) handleError("\nUnable To Parse Topic File:\n");
+			}
+			else ungetc(file_char, topic_file);
+
+			if (!page || page > dimension || weight < 0) handleError("\nInvalid Page in Topic File:\n");
+			if (num_topics == MAX_TOPICS) handleError("\nToo Many Topics in Topic File.\n");
+
+			distribution[num_topics * dimension + page - 1] += weight;
+			in_topic = TRUE;
+		}
+		if (in_topic) num_topics++;
+
+		fclose(topic_file);
+	}
+
+	if (!num_topics) {
+		for (page = 0; page < dimension; page++) distribution[page] = 1;
+		num_topics = 1;
+	}
+
+	topics->num_topics = num_topics;
+	topics->width = getKernelWidth(num_topics);
+	topics->teleport = (double*)calloc(dimension * topics->width, sizeof(double));
+	if (!topics->teleport) handleError("\nUnable To Allocate Memory For Topics.\n");
+
+	for (topic = 0; topic < num_topics; topic++) {
+		topic_sum[topic] = 0;
+		for (index = 0; index < dimension; index++) topic_sum[topic] += distribution[topic * dimension + index];
+		if (topic_sum[topic] <= 0) handleError("\nEmpty Topic in Topic File.\n");
+	}
+
+	/* Interleave the Topics by Page. Padding Topics Never Teleport. */
+	for (index = 0; index < dimension; index++) {
+		for (topic = 0; topic < num_topics; topic++) topics->teleport[index * topics->width + topic] = distribution[topic * dimension + index] / topic_sum[topic];
+	}
+
+	free(distribution);
+
+	return topics;
+}
+
+/*
+ * Deallocates the Topics.
+ * PARAM: topics is a pointer to WebTopics returned by loadTopics.
+ * PRE: NONE
+ * POST: memory for topics released.
+ * RETURN: VOID
+ */
+void freeTopics(WebTopics* topics) {
+	if (!topics) return;
+
+	free(topics->teleport);
+	free(topics);
+}
+
+/*
+ * Calculate the Topic-Sensitive PageRank of Every Topic With the Power Method.
+ *  Note: The Ranks of Every Topic Are Iterated Together. Each Link is Read Once
+ *        Per Iteration and Applied to the Adjacent Ranks of All Topics. Random
+ *        Jumps and the Rank of Dangling Pages Return to the Pages of Each Topic.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PRE: MATLAB engine successfully opened; configuration is specified
+ * 		for topic-sensitive pagerank.
+ * POST: pagerank of each topic stored in a column of MATLAB array x.
+ * RETURN: VOID
+ */
+void calculateTopicSensitive(Engine* ep) {
+	if (!ep) return;
+
+	/* Local Variables */
+	WebGraph *graph = NULL;
+	WebTopics *topics = NULL;
+	WebMatrix *matrix = NULL;
+	WebKernels kernels;
+
+	double *share = NULL;
+	double *scaled = NULL;
+	double *x_prev = NULL;
+	double *x_curr = NULL;
+	double *swap = NULL;
+
+	double jump[MAX_TOPICS];
+	double dangling[MAX_TOPICS];
+	double total[MAX_TOPICS];
+	double residual[MAX_TOPICS];
+	double largest = 0;
+	double value = 0;
+
+	size_t num_topics = 0;
+	size_t width = 0;
+	size_t topic = 0;
+	size_t index = 0;
+	int num_chunks = 0;
+	int chunk = 0;
+	int iterations = 0;
+	clock_t start = 0;
+
+	fprintf(stdout, "\nTopic-Sensitive Power Method Calculation...\n");
+
+	graph = loadWebGraph();
+	topics = loadTopics(graph->dimension);
+	num_topics = topics->num_topics;
+	width = topics->width;
+
+	matrix = loadWebMatrix(graph);
+	kernels = selectKernels(matrix, width);
+	num_chunks = (int)((graph->dimension + KERNEL_PAGES - 1) / KERNEL_PAGES);
+
+	share = (double*)malloc(graph->dimension * sizeof(double));
+	scaled = (double*)malloc(graph->dimension * width * sizeof(double));
+	x_prev = (double*)malloc(graph->dimension * width * sizeof(double));
+	x_curr = (double*)malloc(graph->dimension * width * sizeof(double));
+	if (!share || !scaled || !x_prev || !x_curr) handleError("\nUnable To Allocate Memory For PageRank.\n");
+
+	computeShares(graph, share);
+	for (index = 0; index < graph->dimension * width; index++) x_curr[index] = 1;
+
+	/* Iterate to Calculate PageRank With Power Method Until No Topic's PageRank is Changing. */
+	start = clock();
+	do {
+		swap = x_prev; x_prev = x_curr; x_curr = swap;
+
+		for (topic = 0; topic < width; topic++) {
+			dangling[topic] = 0;
+			total[topic] = 0;
+		}
+		for (index = 0; index < graph->dimension; index++) {
+			for (topic = 0; topic < width; topic++) {
+				value = x_prev[index * width + topic];
+
+				total[topic] += value;
+				if (!graph->out_degree[index]) dangling[topic] += value;
+				scaled[index * width + topic] = share[index] * value;
+			}
+		}
+		for (topic = 0; topic < width; topic++) jump[topic] = DAMPING_FACTOR * dangling[topic] + (1 - DAMPING_FACTOR) * total[topic];
+
+		#pragma omp parallel for schedule(dynamic)
+		for (chunk = 0; chunk < num_chunks; chunk++) {
+			size_t first = (size_t)chunk * KERNEL_PAGES;
+			size_t last = first + KERNEL_PAGES < graph->dimension ? first + KERNEL_PAGES : graph->dimension;
+
+			kernels.spmv(matrix, scaled, jump, topics->teleport, x_curr, first, last);
+		}
+
+		/* Each Topic's Change is Measured Against its Own Total Rank. */
+		for (topic = 0; topic < num_topics; topic++) {
+			residual[topic] = 0;
+			total[topic] = 0;
+		}
+		for (index = 0; index < graph->dimension; index++) {
+			for (topic = 0; topic < num_topics; topic++) {
+				residual[topic] += fabs(x_curr[index * width + topic] - x_prev[index * width + topic]);
+				total[topic] += x_curr[index * width + topic];
+			}
+		}
+
+		largest = 0;
+		for (topic = 0; topic < num_topics; topic++) if (residual[topic] / total[topic] > largest) largest = residual[topic] / total[topic];
+		iterations++;
+	} while (largest > RANK_TOLERANCE);
+
+	fprintf(stdout, "\nTopic-Sensitive Power Method : %i Topics, %i Iterations In %.6f Seconds\n",
+		(int)num_topics, iterations, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	storeTopicPageRank(ep, x_curr, graph->dimension, num_topics, width);
+
+	/* Deallocate Memory. */
+	freeTopics(topics);
+	freeWebMatrix(matrix);
+	freeWebGraph(graph);
+	free(share);
+	free(scaled);
+	free(x_prev);
+	free(x_curr);
+}
+
+/*
+ * Normalize the PageRank of Each Topic and Store Them in the MATLAB Engine.
+ * PARAM: ep is an Engine pointer to a MATLAB process.
+ * PARAM: pagerank is an array of unnormalized page ranks, interleaved by page.
+ * PARAM: dimension is the number of pages.
+ * PARAM: num_topics is the number of topics.
+ * PARAM: width is the number of ranks per page, including padding.
+ * PRE: MATLAB engine successfully opened.
+ * POST: normalized pagerank of each topic stored in a column of MATLAB array x.
+ * RETURN: VOID
+ */
+void storeTopicPageRank(Engine* ep, double* pagerank, size_t dimension, size_t num_topics, size_t width) {
+	if (!ep) return;
+
+	/* Local Variables */
+	size_t page = 0;
+	size_t topic = 0;
+	double total[MAX_TOPICS];
+
+	mxArray *pagerank_array = mxCreateDoubleMatrix(dimension, num_topics, mxREAL);
+	mxDouble *data_pagerank = NULL;
+
+	if (!pagerank_array) handleError("\nUnable To Allocate PageRank Array.\n");
+	else data_pagerank = mxGetPr(pagerank_array);
+
+	for (topic = 0; topic < num_topics; topic++) total[topic] = 0;
+	for (page = 0; page < dimension; page++) {
+		for (topic = 0; topic < num_topics; topic++) total[topic] += pagerank[page * width + topic];
+	}
+
+	/* MATLAB Arrays Are Stored by Column. */
+	for (page = 0; page < dimension; page++) {
+		for (topic = 0; topic < num_topics; topic++) data_pagerank[topic * dimension + page] = pagerank[page * width + topic] / total[topic];
+	}
+
+	if (engPutVariable(ep, "x", pagerank_array)) handleError("\nCannot Write Array to MATLAB.\n");
+
+	mxDestroyArray(pagerank_array);
+}
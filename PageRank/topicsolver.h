@@ -0,0 +1,58 @@
+/*
+ * File: topicsolver.h
+ * Purpose: Contains Constants, Prototypes, Globals
+ * Author: Muntakim Rahman
+ * Date: September 28th 2021
+ */
+
+#pragma once
+
+/*******************/
+/* Include Headers */
+/*******************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "engine.h"
+#include "websolver.h"
+#include "kernels.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/***************************/
+/* Preprocessor Directives */
+/***************************/
+
+/* Each Line Lists the Pages of One Topic, Optionally as page:weight. */
+#define TOPIC_FILE "topics.txt"
+
+/* Topics Are Ranked in One Kernel Batch, and Arrays of MAX_TOPICS Also Hold the Padding. */
+#define MAX_TOPICS KERNEL_MAX_WIDTH
+
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Teleport Distributions of the Topics, Interleaved by Page so the Ranks of
+   Every Topic For One Page Are Adjacent. Each Topic Sums to One. Topics Are
+   Padded to width, the Batch Width of the Specialized Kernels. */
+typedef struct {
+	size_t num_topics;
+	size_t width;
+	double *teleport;
+} WebTopics;
+
+/***********************/
+/* Function Prototypes */
+/***********************/
+
+WebTopics* loadTopics(size_t dimension);
+void freeTopics(WebTopics* topics);
+void calculateTopicSensitive(Engine* ep);
+void storeTopicPageRank(Engine* ep, double* pagerank, size_t dimension, size_t num_topics, size_t width);
@@ -15,19 +15,26 @@
 /*
  * Acquires and Returns the Web Size.
  *  Note: The Matrix is Always a Square. We Only Need to
- *        Find the Length of the Top Row.
+ *        Count the Entries in the Top Row. The Row is Read Character by
+ *        Character so Webs Wider Than the Line Buffer Can Be Sized.
  * PARAM: web_file is a pointer to a filestream
  * PRE: web_file is an initialized pointer to a correctly-formatted text file
  * POST: web_file's internal pointer is set to beginning of stream
- * RETURN: length of the first line of text in the web file EXCLUDING any EOL characters
- *         ('\n' or '\r') and EXCLUDING the string-terminating null ('\0') character.
+ * RETURN: number of space-separated entries in the first line of text in the web file.
  */
 size_t getDimension(FILE* web_file) {
 	/* Local Variables */
 	size_t dimension = 0;
-	char line_buffer[INPUT_BUFF];
+	int file_char = EOF;
+	int in_entry = FALSE;
 
-	dimension = strlen(fgets(line_buffer, INPUT_BUFF, web_file));
+	while ((file_char = fgetc(web_file)) != EOF && file_char != '\n') {
+		if (file_char == ' ' || file_char == '\r') in_entry = FALSE;
+		else if (!in_entry) {
+			in_entry = TRUE;
+			dimension++;
+		}
+	}
 
 	/* Reset the File's Internal Pointer
      to the Beginning of File. */
@@ -37,7 +44,7 @@ size_t getDimension(FILE* web_file) {
     	SEEK_SET // Origin Set as Beginning of File
   	);
 
-	return dimension / OMIT_SPACES;
+	return dimension;
 }
 
 /*
@@ -54,27 +61,16 @@ size_t getDimension(FILE* web_file) {
  */
 void parseMatrix(FILE* web_file, size_t dimension, double** matrix) {
 	/* Variables */
-  	char line_buffer[INPUT_BUFF];
-  	char file_char = '\0';
-
-	size_t line_index = FALSE;
-
 	size_t row = FALSE;
 	size_t column = FALSE;
 
-  	/* Copies Web File to Matrix Line By Line */
-  	while (fgets(line_buffer, INPUT_BUFF, web_file)) {
-		for (column = 0, line_index = 0; column < dimension; line_index++) {
-			file_char = line_buffer[line_index];
-		  	if (file_char != ' ') {
-				file_char -= '0';
-			  	matrix[row][column++] = (double)file_char;
-		  	}
-	  	}
-	row++;
-  	}
-
-	return matrix;
+	/* Copies Web File to Matrix Entry By Entry, so Entries May Be Link Weights. */
+	for (row = 0; row < dimension; row++) {
+		for (column = 0; column < dimension; column++) {
+			if (fscanf(web_file, "%lf", &matrix[row][column]) != TRUE) handleError("\nUnable To Parse Web File:\n");
+			if (matrix[row][column] < 0) handleError("\nNegative Link Weight in Web File:\n");
+		}
+	}
 }
 
 /*
@@ -101,3 +97,177 @@ void printMatrix(Engine *ep, mxArray *test_array, size_t numrows, size_t numcols
 		fprintf(stdout, "\n");
 	}
 }
+
+/*
+ * Reads the Incoming Links of One Page From the Next Row of the Web File.
+ *  Note: Every Loader Reads Rows Here, so Weights Are Kept the Same Way
+ *        Whether the Web is Loaded Whole, Streamed or Split Across Workers.
+ * PARAM: web_file is a pointer to a filestream positioned at the start of a row.
+ * PARAM: dimension is a variable of type size_t representing the size of the matrix.
+ * PARAM: links is a pointer to the WebLinks the row's links are appended to.
+ * PARAM: fail is the function reporting an error, which does not return.
+ * PRE: web_file is a pointer to a correctly-formatted matrix file.
+ * POST: links of the row appended to links; web_file positioned after the row.
+ * RETURN: VOID
+ */
+void readWebRow(FILE* web_file, size_t dimension, WebLinks* links, void (*fail)(char* message)) {
+	/* Local Variables */
+	double entry = 0;
+	size_t column = 0;
+	size_t link = 0;
+
+	/* Links Are Allocated With the First Row, Even IF it Has None. */
+	if (!links->source) {
+		links->capacity = INPUT_BUFF;
+		links->source = (unsigned int*)malloc(links->capacity * sizeof(unsigned int));
+		if (!links->source) fail("\nUnable To Allocate Memory For Web Links.\n");
+	}
+
+	for (column = 0; column < dimension; column++) {
+		if (fscanf(web_file, "%lf", &entry) != TRUE) fail("\nUnable To Parse Web File:\n");
+		if (entry < 0) fail("\nNegative Link Weight in Web File:\n");
+		if (entry == 0) continue;
+
+		if (links->num_links == links->capacity) {
+			links->capacity *= 2;
+			links->source = (unsigned int*)realloc(links->source, links->capacity * sizeof(unsigned int));
+			if (!links->source) fail("\nUnable To Allocate Memory For Web Links.\n");
+			if (links->weight) {
+				links->weight = (double*)realloc(links->weight, links->capacity * sizeof(double));
+				if (!links->weight) fail("\nUnable To Allocate Memory For Web Links.\n");
+			}
+		}
+
+		/* Links Already Read Had Weight One. */
+		if (entry != 1 && !links->weight) {
+			links->weight = (double*)malloc(links->capacity * sizeof(double));
+			if (!links->weight) fail("\nUnable To Allocate Memory For Web Links.\n");
+			for (link = 0; link < links->num_links; link++) links->weight[link] = 1;
+		}
+		if (links->weight) links->weight[links->num_links] = entry;
+
+		links->source[links->num_links++] = (unsigned int)column;
+	}
+}
+
+/*
+ * Loads the Web File Into Incoming and Outgoing Link Lists.
+ *  Note: Each Row of the Web File Lists the Incoming Links of One Page, so
+ *        Incoming Links Are Read in Order and Need No Sorting. Weights Are
+ *        Only Kept Once a Link Has a Weight Other Than One.
+ * PARAM: NONE
+ * PRE: web file is a correctly-formatted matrix file.
+ * POST: NONE
+ * RETURN: dynamically allocated WebGraph, released with freeWebGraph.
+ */
+WebGraph* loadWebGraph(void) {
+	/* Local Variables */
+	FILE *web_file = NULL;
+	WebGraph *graph = NULL;
+	WebLinks links = { 0, 0, NULL, NULL };
+
+	size_t *out_fill = NULL;
+	double entry = 0;
+
+	size_t row = 0;
+	size_t page = 0;
+	size_t edge = 0;
+
+	/* Try to Open and Parse the Web File Containing the Matrix. */
+	if (fopen_s(&web_file, WEB, "r")) handleError("\nUnable To Open Web File:\n");
+	else if (!web_file) handleError("\nUnable To Parse Web File:\n");
+
+	graph = (WebGraph*)calloc(1, sizeof(WebGraph));
+	if (!graph) handleError("\nUnable To Allocate Memory For Web Graph.\n");
+
+	graph->dimension = getDimension(web_file);
+	graph->key = hashWeb(web_file);
+
+	graph->in_start = (size_t*)calloc(graph->dimension + 1, sizeof(size_t));
+	graph->out_degree = (unsigned int*)calloc(graph->dimension + 1, sizeof(unsigned int));
+	graph->out_weight = (double*)calloc(graph->dimension + 1, sizeof(double));
+
+	if (!graph->in_start || !graph->out_degree || !graph->out_weight)
+		handleError("\nUnable To Allocate Memory For Web Graph.\n");
+
+	for (row = 0; row < graph->dimension; row++) {
+		readWebRow(web_file, graph->dimension, &links, handleError);
+
+		for (edge = graph->in_start[row]; edge < links.num_links; edge++) {
+			entry = links.weight ? links.weight[edge] : 1;
+			graph->out_degree[links.source[edge]]++;
+			graph->out_weight[links.source[edge]] += entry;
+		}
+		graph->in_start[row + 1] = links.num_links;
+	}
+	fclose(web_file);
+
+	graph->num_edges = links.num_links;
+	graph->in_source = links.source;
+	graph->in_weight = links.weight;
+
+	if (!graph->in_weight) {
+		free(graph->out_weight);
+		graph->out_weight = NULL;
+	}
+
+	graph->out_start = (size_t*)calloc(graph->dimension + 1, sizeof(size_t));
+	graph->out_target = (unsigned int*)malloc((graph->num_edges + 1) * sizeof(unsigned int));
+	out_fill = (size_t*)malloc((graph->dimension + 1) * sizeof(size_t));
+
+	if (!graph->out_start || !graph->out_target || !out_fill) handleError("\nUnable To Allocate Memory For Web Graph.\n");
+
+	/* Accumulate Outgoing Link Counts Into Offsets, Then Place Each Link at its Source. */
+	for (page = 0; page < graph->dimension; page++) {
+		graph->out_start[page + 1] = graph->out_start[page] + graph->out_degree[page];
+		out_fill[page] = graph->out_start[page];
+	}
+	for (page = 0; page < graph->dimension; page++) {
+		for (edge = graph->in_start[page]; edge < graph->in_start[page + 1]; edge++) graph->out_target[out_fill[graph->in_source[edge]]++] = (unsigned int)page;
+	}
+
+	free(out_fill);
+
+	return graph;
+}
+
+/*
+ * Compute the Damped Fraction of its Rank Each Page Passes Along One Link.
+ *  Note: Pages Divide Their Rank Among Their Links in Proportion to Link Weights,
+ *        so the Share is Scaled by Each Link's Weight Where the Web is Weighted.
+ *        Dangling Pages Pass Nothing Along Links.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PARAM: share is an array receiving the share of each page.
+ * PRE: share holds graph->dimension entries.
+ * POST: share of every page is set.
+ * RETURN: VOID
+ */
+void computeShares(WebGraph* graph, double* share) {
+	/* Local Variables */
+	size_t page = 0;
+
+	for (page = 0; page < graph->dimension; page++) {
+		if (!graph->out_degree[page]) share[page] = 0;
+		else share[page] = DAMPING_FACTOR / (graph->in_weight ? graph->out_weight[page] : graph->out_degree[page]);
+	}
+}
+
+/*
+ * Deallocates a Web Graph.
+ * PARAM: graph is a pointer to a WebGraph returned by loadWebGraph.
+ * PRE: NONE
+ * POST: memory for graph and its link lists released.
+ * RETURN: VOID
+ */
+void freeWebGraph(WebGraph* graph) {
+	if (!graph) return;
+
+	free(graph->in_start);
+	free(graph->in_source);
+	free(graph->out_start);
+	free(graph->out_target);
+	free(graph->out_degree);
+	free(graph->in_weight);
+	free(graph->out_weight);
+	free(graph);
+}
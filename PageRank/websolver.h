@@ -32,6 +32,41 @@
 #define FALSE 0
 #define ERROR -1
 
+/***********************/
+/**** Structures ****/
+/***********************/
+
+/* Links of the Web in Compressed Rows. Incoming Links of Page i Are
+   in_source[in_start[i]] to in_source[in_start[i + 1] - 1]. */
+typedef struct {
+	size_t dimension;
+	size_t num_edges;
+
+	/* Hash of the Web File, Identifying the Web in Checkpoints. */
+	unsigned long long key;
+
+	size_t *in_start;
+	unsigned int *in_source;
+
+	size_t *out_start;
+	unsigned int *out_target;
+	unsigned int *out_degree;
+
+	/* Weights of the Incoming Links, or NULL When Every Link Has Weight One.
+	   out_weight is the Weight Sum of Each Page's Outgoing Links. */
+	double *in_weight;
+	double *out_weight;
+} WebGraph;
+
+/* Incoming Links Read From Rows of the Web File, Appended in Order. Weights Are NULL
+   Until a Link Has a Weight Other Than One, When Every Link Already Read Gets Weight One. */
+typedef struct {
+	size_t num_links;
+	size_t capacity;
+	unsigned int *source;
+	double *weight;
+} WebLinks;
+
 /***********************/
 /* Function Prototypes */
 /***********************/
@@ -40,3 +75,9 @@ size_t getDimension(FILE* web_file);
 
 void parseMatrix(FILE* web_file, size_t dimension, double** matrix);
 void printMatrix(Engine* ep, mxArray* test_array, size_t numrows, size_t numcols);
+
+void readWebRow(FILE* web_file, size_t dimension, WebLinks* links, void (*fail)(char* message));
+
+WebGraph* loadWebGraph(void);
+void computeShares(WebGraph* graph, double* share);
+void freeWebGraph(WebGraph* graph);
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# File: workers.sh
+# Purpose: Starts Distributed Power Method Workers on This Host.
+#          Usage : ./workers.sh <count> <coordinator> [port]
+#                  Starts count Workers For a Coordinator on Another Host, Which
+#                  Must List This Host count Times in its workers.txt.
+#          Usage : ./workers.sh <count>
+#                  Runs the Distributed Power Method on web.txt With count Workers
+#                  Started on This Host, Then Exits.
+# Author: Muntakim Rahman
+# Date: September 28th 2021
+#
+
+PROGRAM=./pagerank
+WORKER_MODE=worker
+WORKER_FILE=workers.txt
+DISTRIBUTED=7
+DEFAULT_PORT=25900
+
+COUNT=$1
+case "$COUNT" in
+	''|*[!0-9]*|0)
+		echo "Usage : $0 <count> [coordinator] [port]" >&2
+		exit 1 ;;
+esac
+
+# Workers For a Remote Coordinator Run Until it Has Gathered the Result.
+if [ -n "$2" ]; then
+	for WORKER in $(seq 1 "$COUNT"); do
+		"$PROGRAM" "$WORKER_MODE" "$2" "${3:-$DEFAULT_PORT}" &
+	done
+	wait
+	exit 0
+fi
+
+# The Coordinator Starts Every Worker Listed as localhost Itself.
+if [ -f "$WORKER_FILE" ]; then mv "$WORKER_FILE" "$WORKER_FILE.bak"; fi
+for WORKER in $(seq 1 "$COUNT"); do echo localhost; done > "$WORKER_FILE"
+
+# The Program Exits With the Same Status Either Way, so Success is Read From its Output.
+LOG=$(mktemp)
+printf "%s\n0\n" "$DISTRIBUTED" | "$PROGRAM" | tee "$LOG"
+grep -q "Distributed Power Method :\|Checkpoint Converged" "$LOG"
+STATUS=$?
+rm -f "$LOG"
+
+rm -f "$WORKER_FILE"
+if [ -f "$WORKER_FILE.bak" ]; then mv "$WORKER_FILE.bak" "$WORKER_FILE"; fi
+exit $STATUS